@@ -0,0 +1,614 @@
+// Exécution par lots de scènes, sans interface graphique
+//
+// Usage : batch [-j N] [-o repertoire] [--cache repertoire] [--log fichier]
+//               [--threshold dBm] [--csv] [--place K] [--stats-only] [--tiled]
+//               [--quantized] [--engine exact|dda|rayfan|polar] [--precision double|float]
+//               [--verify] [--max-error dB] [--max-flipped fraction]
+//               [--sinr] [--noise dBm] [--resilience] [--channels N]
+//               [--throughput] [--mcs-table fichier] [--frequencies f1,f2,...] [--bands]
+//               scene1.txt scene2.txt @liste.txt ...
+//
+// Les scènes sont réparties sur les cœurs disponibles : plusieurs scènes en parallèle,
+// chacune calculée par tuiles sur sa part des cœurs (jamais plus de N threads au total).
+// Chaque scène terminée est ajoutée au journal de progression, avec une empreinte des options
+// qui changent ses sorties ; relancé avec le même journal et les mêmes options, le lot reprend là
+// où il s'était arrêté (une scène calculée avec d'autres options est recalculée). Un lot avec
+// --verify ne reprend jamais : toutes ses scènes sont recalculées et comparées.
+// Avec --place K, K émetteurs sont d'abord placés au mieux (voir optimizer.hpp) et la
+// scène complétée est enregistrée à côté de la carte.
+// Avec --stats-only, seules les statistiques et l'histogramme sont produits, sans jamais
+// garder la carte en mémoire (voir coverage.hpp). Avec --tiled, la carte est calculée dans
+// un fichier par tuiles (voir tiled_map.hpp), pour les surfaces qui ne tiennent pas en mémoire.
+// Avec --quantized, la carte est gardée en centièmes de dBm sur 16 bits (4 fois moins de mémoire).
+// --engine remplace le moteur de calcul déclaré par les scènes (ENGINE), --precision leur précision
+// (PRECISION). Avec --verify, la carte d'un moteur approché ou en float est comparée à celle du
+// moteur exact en double (calculée en plus) et l'écart affiché, puis résumé sur tout le lot ; une
+// scène dont l'écart maximal dépasse --max-error dB (0.01 par défaut) ou dont la part de points
+// basculés dépasse --max-flipped (0.001 par défaut) est hors tolérance, et le lot se termine en
+// erreur (code 3). make verify vérifie ainsi le corpus de scènes de référence (assets/scenes).
+// Avec --sinr, les cartes de desserte (voir Room::computeServingMaps) sont aussi exportées en CSV :
+// SINR, interférence et indice du meilleur émetteur, avec un bruit de fond de --noise dBm.
+// Avec --resilience, la couverture restante en cas de panne de chaque émetteur est exportée en
+// CSV, tirée des deux meilleurs émetteurs de chaque point (moteur exact ; calculée sans passer par
+// --cache, qui ne garde pas les meilleurs émetteurs).
+// Avec --channels N, un plan de N canaux est cherché à partir des couches par émetteur (voir
+// channel_planner.hpp ; avec --cache, les entrées sans couches sont recalculées) et exporté en CSV,
+// avec --threshold et --noise. Ces deux options demandent la carte en mémoire (ni --stats-only ni
+// --tiled) ; une scène dont l'export n'a pas pu être produit est en erreur.
+// Avec --throughput, le MCS et le débit attendu de chaque point sont tirés de son SINR dans la
+// passe des cartes de desserte et exportés en CSV, avec la table de --mcs-table (voir throughput.hpp).
+// Avec --frequencies f1,f2,... (Hz), une carte par fréquence, tous les émetteurs évalués à cette
+// fréquence, est exportée en CSV (-2.4GHz.csv, ...) ; avec --bands, une carte par fréquence distincte
+// des émetteurs, chacun dans sa bande (-bande-2.4GHz.csv, ...). L'occlusion n'est calculée qu'une
+// fois pour toutes les cartes (Room::computeMultiFrequencyMaps / computeBandMaps, moteur exact).
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "headers/room.hpp"
+#include "headers/scene.hpp"
+#include "headers/map_cache.hpp"
+#include "headers/parallel.hpp"
+#include "headers/optimizer.hpp"
+#include "headers/channel_planner.hpp"
+#include "headers/throughput.hpp"
+#include "headers/coverage.hpp"
+#include "headers/tiled_map.hpp"
+
+namespace {
+
+struct BatchOptions {
+    int threads = 0;
+    std::string outputDir = "results";
+    std::string cacheDir;
+    std::string logFile;
+    double threshold = -67.0;
+    bool csv = false;
+    int place = 0;          // Émetteurs à placer avant le calcul
+    bool statsOnly = false; // Statistiques sans carte
+    bool tiled = false;     // Carte par tuiles sur disque
+    bool quantized = false; // Carte en centièmes de dBm sur 16 bits
+    std::string engine;     // Moteur imposé (vide = celui de la scène)
+    std::string precision;  // Précision imposée (vide = celle de la scène)
+    bool verify = false;    // Mesurer l'écart au moteur exact
+    double maxError = 0.01;     // Tolérance de --verify : écart maximal (dB)
+    double maxFlipped = 0.001;  // Tolérance de --verify : part des points basculés
+    bool sinr = false;      // Exporter les cartes de desserte
+    double noise = Room::THERMAL_NOISE; // Bruit de fond du SINR (dBm)
+    bool resilience = false; // Exporter la couverture en cas de panne de chaque émetteur
+    int channels = 0;        // Canaux du plan à chercher (0 = pas de plan)
+    bool throughput = false; // Exporter les cartes de MCS et de débit
+    std::string mcsTable;    // Table SINR -> MCS -> débit (vide = table par défaut)
+    std::vector<double> frequencies; // Fréquences des cartes multi-fréquences (Hz, vide = aucune)
+    bool bands = false;      // Exporter une carte par bande des émetteurs
+    std::vector<std::string> scenes;
+};
+
+// Résultat d'une scène, tel qu'enregistré dans le journal
+struct SceneSummary {
+    std::string scene;
+    std::string hash;
+    std::string options;    // Empreinte des options du calcul (optionsFingerprint)
+    int width = 0, height = 0;
+    size_t emitters = 0, obstacles = 0;
+    double minPower = 0, maxPower = 0, meanPower = 0;
+    double coverage = 0;    // Pourcentage de points au-dessus du seuil
+    double seconds = 0;
+};
+
+void usage() {
+    std::cerr << "Usage: batch [-j N] [-o repertoire] [--cache repertoire] [--log fichier]"
+                 " [--threshold dBm] [--csv] [--place K] [--stats-only] [--tiled] [--quantized]"
+                 " [--engine exact|dda|rayfan|polar] [--precision double|float] [--verify]"
+                 " [--max-error dB] [--max-flipped fraction]"
+                 " [--sinr] [--noise dBm] [--resilience] [--channels N] [--throughput] [--mcs-table fichier]"
+                 " [--frequencies f1,f2,...] [--bands]"
+                 " scene... @liste..." << std::endl;
+}
+
+bool parseArguments(int argc, char** argv, BatchOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "-j" && hasValue) options.threads = std::atoi(argv[++i]);
+        else if (arg == "-o" && hasValue) options.outputDir = argv[++i];
+        else if (arg == "--cache" && hasValue) options.cacheDir = argv[++i];
+        else if (arg == "--log" && hasValue) options.logFile = argv[++i];
+        else if (arg == "--threshold" && hasValue) options.threshold = std::atof(argv[++i]);
+        else if (arg == "--csv") options.csv = true;
+        else if (arg == "--place" && hasValue) options.place = std::atoi(argv[++i]);
+        else if (arg == "--stats-only") options.statsOnly = true;
+        else if (arg == "--tiled") options.tiled = true;
+        else if (arg == "--quantized") options.quantized = true;
+        else if (arg == "--verify") options.verify = true;
+        else if (arg == "--max-error" && hasValue) options.maxError = std::atof(argv[++i]);
+        else if (arg == "--max-flipped" && hasValue) options.maxFlipped = std::atof(argv[++i]);
+        else if (arg == "--sinr") options.sinr = true;
+        else if (arg == "--noise" && hasValue) options.noise = std::atof(argv[++i]);
+        else if (arg == "--resilience") options.resilience = true;
+        else if (arg == "--channels" && hasValue) options.channels = std::atoi(argv[++i]);
+        else if (arg == "--throughput") options.throughput = true;
+        else if (arg == "--mcs-table" && hasValue) options.mcsTable = argv[++i];
+        else if (arg == "--bands") options.bands = true;
+        else if (arg == "--frequencies" && hasValue) {
+            std::istringstream list(argv[++i]);
+            std::string value;
+            while (std::getline(list, value, ',')) {
+                const double frequency = std::atof(value.c_str());
+                if (frequency <= 0) return false;
+                options.frequencies.push_back(frequency);
+            }
+        }
+        else if (arg == "--engine" && hasValue) {
+            PropagationEngine engine;
+            options.engine = argv[++i];
+            if (!parseEngine(options.engine, engine)) return false;
+        }
+        else if (arg == "--precision" && hasValue) {
+            Precision precision;
+            options.precision = argv[++i];
+            if (!parsePrecision(options.precision, precision)) return false;
+        }
+        else if (arg[0] == '@') {
+            // Fichier listant une scène par ligne
+            std::ifstream list(arg.substr(1));
+            if (!list) {
+                std::cerr << "Impossible d'ouvrir le fichier: " << arg.substr(1) << std::endl;
+                return false;
+            }
+            std::string line;
+            while (std::getline(list, line)) {
+                if (!line.empty() && line.back() == '\r') line.pop_back();
+                if (!line.empty() && line[0] != '#') options.scenes.push_back(line);
+            }
+        }
+        else if (arg[0] == '-') return false;
+        else options.scenes.push_back(arg);
+    }
+    if ((options.resilience || options.channels > 0) && (options.statsOnly || options.tiled)) {
+        std::cerr << "--resilience et --channels demandent la carte en memoire (sans --stats-only ni --tiled)" << std::endl;
+        return false;
+    }
+    if (options.resilience && !options.engine.empty() && options.engine != engineName(PropagationEngine::Exact)) {
+        std::cerr << "--resilience demande le moteur exact" << std::endl;
+        return false;
+    }
+    if (options.logFile.empty()) {
+        options.logFile = (std::filesystem::path(options.outputDir) / "progress.log").string();
+    }
+    return !options.scenes.empty();
+}
+
+std::string hashHex(uint64_t hash) {
+    std::ostringstream os;
+    os << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return os.str();
+}
+
+/**
+ * Empreinte (FNV-1a 64 bits, comme Room::sceneHash) des options qui changent les sorties d'une
+ * scène : répertoire, seuil, exports, moteur, placement... Ni -j, ni --cache, ni --log, ni les
+ * options de --verify, qui ne changent pas les fichiers produits
+ */
+std::string optionsFingerprint(const BatchOptions& o) {
+    std::ostringstream description;
+    description << std::setprecision(17) << o.outputDir << "\n" << o.threshold << " " << o.csv << " " << o.place << " "
+                << o.statsOnly << " " << o.tiled << " " << o.quantized << " " << o.engine << " " << o.precision << " "
+                << o.sinr << " " << o.noise << " " << o.resilience << " " << o.channels << " " << o.throughput << " "
+                << o.bands << "\n";
+    for (double frequency : o.frequencies) description << frequency << " ";
+    if (!o.mcsTable.empty()) {
+        std::ifstream table(o.mcsTable);
+        description << "\n" << table.rdbuf(); // Contenu de la table : modifiée, les débits changent
+    }
+
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : description.str()) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hashHex(hash);
+}
+
+std::string formatSummary(const SceneSummary& s) {
+    std::ostringstream os;
+    os << "DONE\t" << s.scene << "\t" << s.hash << "\t" << s.width << "\t" << s.height << "\t"
+       << s.emitters << "\t" << s.obstacles << "\t" << s.minPower << "\t" << s.maxPower << "\t"
+       << s.meanPower << "\t" << s.coverage << "\t" << s.seconds << "\t" << s.options;
+    return os.str();
+}
+
+bool parseSummary(const std::string& line, SceneSummary& s) {
+    std::istringstream in(line);
+    std::string field;
+    std::vector<std::string> fields;
+    while (std::getline(in, field, '\t')) fields.push_back(field);
+    if (fields.size() != 13 || fields[0] != "DONE") return false; // Lignes sans empreinte : recalculées
+    s.scene = fields[1];
+    s.hash = fields[2];
+    s.width = std::atoi(fields[3].c_str());
+    s.height = std::atoi(fields[4].c_str());
+    s.emitters = std::strtoul(fields[5].c_str(), nullptr, 10);
+    s.obstacles = std::strtoul(fields[6].c_str(), nullptr, 10);
+    s.minPower = std::atof(fields[7].c_str());
+    s.maxPower = std::atof(fields[8].c_str());
+    s.meanPower = std::atof(fields[9].c_str());
+    s.coverage = std::atof(fields[10].c_str());
+    s.seconds = std::atof(fields[11].c_str());
+    s.options = fields[12];
+    return true;
+}
+
+// Statistiques de la carte, hors obstacles (-555) comme dans l'affichage
+void fillStatistics(const CoverageStatistics& stats, SceneSummary& s) {
+    s.minPower = stats.all.min;
+    s.maxPower = stats.all.max;
+    s.meanPower = stats.all.mean();
+    s.coverage = 100.0 * stats.all.coverage();
+}
+
+void writeSummaryTable(const BatchOptions& options, const std::vector<SceneSummary>& summaries) {
+    const std::string path = (std::filesystem::path(options.outputDir) / "summary.csv").string();
+    std::ofstream file(path);
+    file << "scene,hash,width,height,emitters,obstacles,min_dbm,max_dbm,mean_dbm,coverage_pct,seconds\n";
+    for (const auto& s : summaries) {
+        file << s.scene << "," << s.hash << "," << s.width << "," << s.height << "," << s.emitters << ","
+             << s.obstacles << "," << s.minPower << "," << s.maxPower << "," << s.meanPower << ","
+             << s.coverage << "," << s.seconds << "\n";
+    }
+
+    std::cout << std::left << std::setw(32) << "Scene" << std::right << std::setw(10) << "Min"
+              << std::setw(10) << "Max" << std::setw(10) << "Moyenne" << std::setw(12) << "Couverture"
+              << std::setw(10) << "Temps" << std::endl;
+    for (const auto& s : summaries) {
+        std::cout << std::left << std::setw(32) << std::filesystem::path(s.scene).filename().string()
+                  << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(10) << s.minPower << std::setw(10) << s.maxPower
+                  << std::setw(10) << s.meanPower << std::setw(11) << s.coverage << "%"
+                  << std::setw(9) << s.seconds << "s" << std::endl;
+    }
+    std::cout << "Tableau recapitulatif ecrit dans " << path << std::endl;
+}
+
+// Applique les choix de la ligne de commande à une scène chargée
+void applyOverrides(const BatchOptions& options, Room& room) {
+    if (!options.engine.empty()) parseEngine(options.engine, room.engine);
+    if (!options.precision.empty()) parsePrecision(options.precision, room.precision);
+}
+
+// Carte du moteur exact en double, calculée dans la salle puis copiée (moteur et précision de la salle rétablis)
+std::vector<std::vector<double>> exactReference(Room& room) {
+    const PropagationEngine engine = room.engine;
+    const Precision precision = room.precision;
+    room.engine = PropagationEngine::Exact;
+    room.precision = Precision::Double;
+    room.computeSignalMap();
+    room.engine = engine;
+    room.precision = precision;
+
+    std::vector<std::vector<double>> reference(room.height, std::vector<double>(room.width));
+    const std::unique_ptr<PowerMapReader> reader = room.mapReader();
+    for (int y = 0; y < room.height; y++) reader->readRow(y, 0, room.width, reference[y].data());
+    return reference;
+}
+
+// Carte d'indices (meilleur émetteur, MCS) convertie pour l'export CSV
+std::vector<std::vector<double>> toDoubles(const std::vector<std::vector<int>>& map) {
+    std::vector<std::vector<double>> result(map.size());
+    for (size_t y = 0; y < map.size(); y++) result[y].assign(map[y].begin(), map[y].end());
+    return result;
+}
+
+// Cartes d'un calcul multi-fréquence, une par fréquence : chemin-<prefixe><f>GHz.csv
+void exportFrequencyMaps(const std::vector<std::vector<std::vector<double>>>& maps, const std::vector<double>& frequencies,
+                         const std::string& path, const std::string& prefix) {
+    for (size_t m = 0; m < maps.size(); m++) {
+        std::ostringstream name;
+        name << path << "-" << prefix << frequencies[m] / 1e9 << "GHz.csv";
+        InMemoryMapReader reader(maps[m]);
+        exportMapToCSV(reader, name.str());
+    }
+}
+
+// Couverture restante en cas de panne de chaque émetteur (room.bestServers rempli par le calcul)
+// Faux si elle n'a pas pu être calculée (moteur approché déclaré par la scène) ou écrite
+bool exportResilience(const Room& room, double threshold, const std::string& path) {
+    const std::vector<double> coverage = room.singleFailureCoverage(threshold);
+    if (coverage.empty()) {
+        std::cerr << "Couverture en cas de panne indisponible pour " << path << " (moteur exact requis)" << std::endl;
+        return false;
+    }
+    std::ofstream file(path);
+    file << "emitter,x,y,coverage_pct\n";
+    for (size_t e = 0; e < coverage.size(); e++) {
+        file << e << "," << room.emitters[e].getX() << "," << room.emitters[e].getY() << "," << coverage[e] << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+// Plan de canaux cherché sur les couches par émetteur (room.emitterLayers remplies par le calcul)
+// Faux si aucun plan n'a été produit ou écrit
+bool exportChannelPlan(const Room& room, const BatchOptions& options, const std::string& path) {
+    ChannelPlanOptions plan;
+    plan.channels = options.channels;
+    plan.threshold = options.threshold;
+    plan.noise = options.noise;
+    plan.threads = room.threads;
+    const ChannelPlanResult result = planChannels(room, plan);
+    if (result.channels.empty()) return false;
+    std::ofstream file(path);
+    file << "emitter,x,y,channel\n";
+    for (size_t e = 0; e < result.channels.size(); e++) {
+        file << e << "," << room.emitters[e].getX() << "," << room.emitters[e].getY() << "," << result.channels[e] << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BatchOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        usage();
+        return 1;
+    }
+    ThroughputTable table;
+    if (!options.mcsTable.empty() && !table.load(options.mcsTable)) return 1;
+    std::filesystem::create_directories(options.outputDir);
+
+    // Reprise : scènes déjà terminées dans le journal (même chemin, mêmes options, même hash),
+    // sauf pour une vérification
+    const std::string fingerprint = optionsFingerprint(options);
+    std::map<std::string, SceneSummary> done;
+    if (!options.verify) {
+        std::ifstream log(options.logFile);
+        std::string line;
+        SceneSummary s;
+        while (std::getline(log, line)) {
+            if (parseSummary(line, s) && s.options == fingerprint) done[s.scene] = s;
+        }
+    }
+
+    std::vector<SceneSummary> summaries(options.scenes.size());
+    std::vector<bool> finished(options.scenes.size(), false);
+    std::vector<int> pending;
+    for (size_t i = 0; i < options.scenes.size(); i++) {
+        auto it = done.find(options.scenes[i]);
+        if (it != done.end()) {
+            Room* room = loadScene(options.scenes[i], false);
+            if (room) applyOverrides(options, *room);
+            if (room && hashHex(room->sceneHash()) == it->second.hash) {
+                summaries[i] = it->second;
+                finished[i] = true;
+            }
+            deleteScene(room);
+        }
+        if (!finished[i]) pending.push_back(static_cast<int>(i));
+    }
+    std::cout << options.scenes.size() - pending.size() << " scene(s) deja calculee(s), "
+              << pending.size() << " a calculer" << std::endl;
+
+    const int cores = options.threads > 0 ? options.threads : hardwareThreads();
+    const int workers = std::max(1, std::min(cores, static_cast<int>(pending.size())));
+
+    std::ofstream log(options.logFile, std::ios::app);
+    std::mutex logMutex;
+    std::atomic<int> next(0);
+    std::atomic<int> failures(0);
+    // Cœurs au-delà du thread de chaque worker : réservés au démarrage d'une scène, rendus à
+    // sa fin, pour que la somme des threads des scènes en cours ne dépasse jamais cores
+    std::atomic<int> spareCores(cores - workers);
+    std::atomic<int> running(0);
+    MapComparison worst;    // Écarts cumulés des scènes vérifiées (maxError : pire scène)
+    int verified = 0;
+    std::atomic<int> outOfTolerance(0);
+
+    auto worker = [&]() {
+        for (int k = next++; k < static_cast<int>(pending.size()); k = next++) {
+            const int index = pending[k];
+            const std::string& scene = options.scenes[index];
+            const bool inMemory = !options.statsOnly && !options.tiled;
+            Room* room = loadScene(scene, inMemory && !options.quantized);
+            if (!room) {
+                failures++;
+                continue;
+            }
+            applyOverrides(options, *room);
+            if (inMemory && options.quantized) room->setQuantizedStorage(true);
+
+            // Part des cœurs libres entre les workers sans scène : les cœurs libérés par les scènes
+            // terminées reviennent aux tuiles des dernières scènes
+            const int remaining = static_cast<int>(pending.size()) - k;
+            const int idle = std::max(1, std::min(workers - running++, remaining));
+            int spare = spareCores.load();
+            int reserved = spare / idle;
+            while (!spareCores.compare_exchange_weak(spare, spare - reserved)) reserved = spare / idle;
+            room->threads = 1 + reserved;
+            auto release = [&]() {
+                spareCores += reserved;
+                running--;
+            };
+
+            // Hash de la scène d'entrée, avant placement, pour la reprise
+            SceneSummary& s = summaries[index];
+            s.scene = scene;
+            s.hash = hashHex(room->sceneHash());
+            s.options = fingerprint;
+            const std::string stem = std::filesystem::path(scene).stem().string() + "-" + s.hash;
+            const std::filesystem::path output = std::filesystem::path(options.outputDir) / stem;
+
+            CoverageOptions coverage;
+            coverage.threshold = options.threshold;
+
+            const auto start = std::chrono::steady_clock::now();
+            if (options.place > 0) {
+                PlacementOptions placement;
+                placement.emitterCount = options.place;
+                placement.threshold = options.threshold;
+                placement.threads = room->threads;
+                for (const Emitter& emitter : optimizePlacement(*room, placement).emitters) {
+                    room->addEmitter(emitter);
+                }
+                saveScene(*room, output.string() + "-placed.txt");
+            }
+            CoverageStatistics stats(coverage);
+            if (options.statsOnly) {
+                stats = computeCoverageStatistics(*room, coverage);
+            } else if (options.tiled) {
+                TiledMap map(*room, output.string() + ".tiles");
+                if (!map.isOpen()) {
+                    failures++;
+                    release();
+                    deleteScene(room);
+                    continue;
+                }
+                // Tuile impossible à projeter : cette scène seulement est en erreur
+                bool complete = map.computeAll();
+                if (complete) {
+                    stats = coverageStatisticsFromMap(map, coverage);
+                    if (options.csv) exportMapToCSV(map, output.string() + ".csv");
+                    complete = !map.hasFailed();
+                }
+                if (!complete) {
+                    failures++;
+                    release();
+                    deleteScene(room);
+                    continue;
+                }
+            } else {
+                std::vector<std::vector<double>> reference;
+                if (options.verify && (room->engine != PropagationEngine::Exact || room->precision != Precision::Double)) {
+                    reference = exactReference(*room);
+                }
+                if (options.resilience) room->keepBestServers = 2;
+                if (options.channels > 0) room->keepEmitterLayers = true; // Exigées aussi d'une entrée du cache
+                if (options.cacheDir.empty() || options.resilience) {
+                    room->computeSignalMap(); // Meilleurs émetteurs absents des entrées du cache
+                } else {
+                    MapCache(options.cacheDir).computeSignalMap(*room);
+                }
+                if (!reference.empty()) {
+                    InMemoryMapReader exact(reference);
+                    const MapComparison diff = compareMaps(exact, *room->mapReader());
+                    const bool withinTolerance = diff.maxError <= options.maxError && diff.flippedFraction() <= options.maxFlipped;
+                    std::ostringstream report;
+                    report << scene << " : moteur " << engineName(room->engine) << " en " << precisionName(room->precision)
+                           << ", " << diff.differing << "/" << diff.points << " points differents du calcul exact, "
+                           << diff.flipped << " bascules, ecart max " << diff.maxError
+                           << " dB, moyen " << diff.meanError << " dB\n";
+                    if (!withinTolerance) {
+                        outOfTolerance++;
+                        report << scene << " : HORS TOLERANCE (ecart max " << options.maxError << " dB, "
+                               << options.maxFlipped * 100 << " % de points bascules au plus)\n";
+                    }
+                    std::cout << report.str();
+
+                    std::lock_guard<std::mutex> lock(logMutex);
+                    verified++;
+                    worst.points += diff.points;
+                    worst.differing += diff.differing;
+                    worst.flipped += diff.flipped;
+                    worst.maxError = std::max(worst.maxError, diff.maxError);
+                }
+                bool exported = true;
+                if (options.channels > 0) exported &= exportChannelPlan(*room, options, output.string() + "-channels.csv");
+                room->markObstaclesOnPowerMap();
+                if (options.resilience) exported &= exportResilience(*room, options.threshold, output.string() + "-resilience.csv");
+                if (!exported) {
+                    failures++;
+                    release();
+                    deleteScene(room);
+                    continue;
+                }
+                stats = coverageStatisticsFromMap(*room->mapReader(), coverage);
+            }
+
+            s.width = room->width;
+            s.height = room->height;
+            s.emitters = room->emitters.size();
+            s.obstacles = room->obstacles.size();
+            fillStatistics(stats, s);
+
+            stats.exportHistogram(output.string() + "-histogram.csv");
+            if (!options.statsOnly && !options.tiled) {
+                room->exportToBinary(output.string() + ".pmap");
+                if (options.csv) room->exportToCSV(output.string() + ".csv");
+            }
+            if ((options.sinr || options.throughput) && !options.statsOnly && !options.tiled) {
+                const ServingMaps serving = room->computeServingMaps(options.noise, options.throughput ? &table : nullptr);
+                if (options.sinr) {
+                    const std::vector<std::vector<double>> server = toDoubles(serving.bestServer);
+                    InMemoryMapReader sinr(serving.sinr), interference(serving.interference), best(server);
+                    exportMapToCSV(sinr, output.string() + "-sinr.csv");
+                    exportMapToCSV(interference, output.string() + "-interference.csv");
+                    exportMapToCSV(best, output.string() + "-server.csv");
+                }
+                if (options.throughput) {
+                    const std::vector<std::vector<double>> mcs = toDoubles(serving.mcs);
+                    InMemoryMapReader throughput(serving.throughput), mcsReader(mcs);
+                    exportMapToCSV(throughput, output.string() + "-throughput.csv");
+                    exportMapToCSV(mcsReader, output.string() + "-mcs.csv");
+                }
+            }
+            if (!options.frequencies.empty() && !options.statsOnly && !options.tiled) {
+                exportFrequencyMaps(room->computeMultiFrequencyMaps(options.frequencies), options.frequencies, output.string(), "");
+            }
+            if (options.bands && !options.statsOnly && !options.tiled) {
+                std::vector<double> bands;
+                const auto maps = room->computeBandMaps(bands);
+                exportFrequencyMaps(maps, bands, output.string(), "bande-");
+            }
+            s.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            {
+                std::lock_guard<std::mutex> lock(logMutex);
+                log << formatSummary(s) << std::endl; // Vidé à chaque scène pour la reprise
+                finished[index] = true;
+                std::cout << "[" << k + 1 << "/" << pending.size() << "] " << scene << " ("
+                          << room->threads << " threads, " << s.seconds << " s)" << std::endl;
+            }
+            release();
+            deleteScene(room);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < workers; t++) pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool) th.join();
+
+    std::vector<SceneSummary> completed;
+    for (size_t i = 0; i < summaries.size(); i++) {
+        if (finished[i]) completed.push_back(summaries[i]);
+    }
+    writeSummaryTable(options, completed);
+    if (verified > 0) {
+        // Format du tableau récapitulatif (une décimale) remis à défaut : l'écart max du float est en 1e-5 dB
+        std::cout << std::defaultfloat << std::setprecision(6);
+        std::cout << "Verification sur " << verified << " scene(s) : " << worst.flipped << "/" << worst.points
+                  << " points bascules, " << worst.differing << " differents, ecart max " << worst.maxError
+                  << " dB" << std::endl;
+    }
+
+    if (failures > 0) {
+        std::cerr << failures << " scene(s) en erreur" << std::endl;
+        return 2;
+    }
+    if (outOfTolerance > 0) {
+        std::cerr << outOfTolerance << " scene(s) hors tolerance" << std::endl;
+        return 3;
+    }
+    return 0;
+}
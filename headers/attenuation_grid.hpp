@@ -0,0 +1,51 @@
+#ifndef ATTENUATION_GRID_HPP
+#define ATTENUATION_GRID_HPP
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "room.hpp"
+#include "occlusion_engine.hpp"
+
+/**
+ * Obstacles de la salle rastérisés une fois sur la grille des pixels, pour le moteur DDA
+ *
+ * Chaque cellule (pixel (i, j), carré [i-0.5, i+0.5) x [j-0.5, j+0.5)) référence les obstacles
+ * dont la forme la recouvre, même en partie (Obstacle::overlapsBox), en distinguant les cellules
+ * entièrement intérieures des cellules de bord. L'occlusion d'un rayon est obtenue en parcourant
+ * les cellules qu'il traverse (Amanatides–Woo) : un obstacle dont le rayon traverse une cellule
+ * intérieure est compté directement, un obstacle seulement effleuré par ses cellules de bord est
+ * vérifié par isBlocking. Chaque obstacle compte au plus une fois, comme avec le calcul exact.
+ * Le coût dépend de la longueur du rayon et des bords rencontrés, plus du nombre d'obstacles.
+ * Les obstacles doivent être convexes, et plus épais qu'un demi-pixel pour être vus à coup sûr.
+ */
+class AttenuationGrid : public OcclusionEngine {
+public:
+    explicit AttenuationGrid(const Room& room);
+
+    /**
+     * Atténuation totale des obstacles entre une position d'émission et le centre d'un pixel
+     * @param scratch Tampon de travail (obstacles rencontrés), réutilisé d'un appel à l'autre
+     */
+    double occlusion(double emitter_x, double emitter_y, int x, int y, std::vector<uint32_t>& scratch) const;
+
+    double occlusion(size_t emitter, int x, int y, std::vector<uint32_t>& scratch) const override {
+        return occlusion(emitterPositions[emitter].first, emitterPositions[emitter].second, x, y, scratch);
+    }
+
+    // Nombre de cellules recouvertes par au moins un obstacle
+    size_t coveredCells() const;
+
+private:
+    static constexpr uint32_t INTERIOR = 0x80000000u; // Dans sets : cellule entièrement dans l'obstacle
+    static constexpr uint32_t PENDING = 0x80000000u;  // Dans scratch : obstacle effleuré, à vérifier
+
+    int width, height;
+    std::vector<uint32_t> cells;                 // Indice dans sets (0 = cellule libre)
+    std::vector<std::vector<uint32_t>> sets;     // Ensembles d'obstacles distincts, sets[0] vide
+    std::vector<double> attenuations;            // Atténuation de chaque obstacle
+    std::vector<const Obstacle*> obstacles;      // Pour la vérification des cellules de bord
+    std::vector<std::pair<double, double>> emitterPositions;
+};
+
+#endif // ATTENUATION_GRID_HPP
@@ -0,0 +1,45 @@
+#ifndef CHANNEL_PLANNER_HPP
+#define CHANNEL_PLANNER_HPP
+
+#include <vector>
+#include "room.hpp"
+
+/**
+ * Paramètres de la recherche d'une affectation de canaux
+ */
+struct ChannelPlanOptions {
+    int channels = 3;               // Canaux disponibles (ex. 1, 6, 11 en 2,4 GHz)
+    double threshold = -67.0;       // Seuil de desserte (dBm) : seuls les points servis sont évalués
+    double minSinr = 10.0;          // SINR minimal d'un point servi (dB), sous lequel il est interféré
+    double noise = Room::THERMAL_NOISE; // Bruit de fond (dBm)
+    int downsample = 4;             // Pas de la grille d'évaluation (pixels)
+    int iterations = 1000;          // Passes maximales de la recherche locale (0 = glouton seul)
+    int threads = 0;                // Threads d'évaluation (0 = tous les cœurs)
+};
+
+/**
+ * Résultat de la recherche
+ */
+struct ChannelPlanResult {
+    std::vector<int> channels;      // Canal de chaque émetteur (0 .. channels - 1), vide si échec
+    double servedArea = 0.0;        // Fraction des points évalués servis au-dessus du seuil
+    double interferedArea = 0.0;    // Fraction des points servis sous minSinr
+    long evaluations = 0;           // Nombre d'affectations évaluées
+    double seconds = 0.0;
+};
+
+/**
+ * Cherche le canal de chaque émetteur qui minimise la surface interférée : points servis dont
+ * le SINR (meilleur émetteur contre les émetteurs de son canal) est sous minSinr
+ *
+ * Chaque point est servi par son meilleur émetteur quel que soit le plan. Les puissances sont
+ * lues dans les couches par émetteur de la salle (Room::keepEmitterLayers, calculées par
+ * computeSignalMap) sur une grille de pas downsample, puis gardées par point en mW avec la
+ * somme de l'interférence par canal : changer le canal d'un émetteur ne touche que les points
+ * où il sert ou interfère, sans recalcul de carte. Affectation gloutonne (émetteurs par surface
+ * servie décroissante), puis recherche locale : à chaque passe, tous les changements d'un canal
+ * sont évalués en parallèle et le meilleur est appliqué, jusqu'à ce qu'aucun n'améliore le plan
+ */
+ChannelPlanResult planChannels(const Room& room, const ChannelPlanOptions& options);
+
+#endif // CHANNEL_PLANNER_HPP
@@ -0,0 +1,82 @@
+#ifndef COVERAGE_HPP
+#define COVERAGE_HPP
+
+#include <string>
+#include <vector>
+#include "room.hpp"
+#include "map_reader.hpp"
+
+/**
+ * Zone nommée de la salle (pièce, couloir...) sur laquelle on veut des statistiques séparées
+ */
+struct CoverageZone {
+    std::string name;
+    Tile area;      // Pixels [x0, x1) x [y0, y1)
+};
+
+/**
+ * Paramètres des statistiques de couverture
+ */
+struct CoverageOptions {
+    double threshold = -67.0;       // Seuil de couverture (dBm)
+    double histogramMin = -100.0;   // Borne basse de l'histogramme (dBm)
+    double histogramMax = 20.0;     // Borne haute ; les valeurs hors bornes vont dans la première/dernière classe
+    double binWidth = 1.0;          // Largeur d'une classe (dB)
+    std::vector<CoverageZone> zones;
+};
+
+/**
+ * Moyenne, minimum et maximum de la puissance sur un ensemble de points
+ */
+struct ZoneStatistics {
+    long count = 0;
+    long covered = 0;       // Points au-dessus du seuil
+    double sum = 0.0;
+    double min = 0.0, max = 0.0;
+
+    void add(double power, bool aboveThreshold);
+    void merge(const ZoneStatistics& other);
+    double mean() const { return count ? sum / count : 0.0; }
+    double coverage() const { return count ? static_cast<double>(covered) / count : 0.0; }
+};
+
+/**
+ * Résumé d'une carte : histogramme, couverture au-dessus du seuil, statistiques par zone
+ * Les points obstacles (marqués -555 sur powerMap) sont exclus, comme dans l'affichage
+ */
+struct CoverageStatistics {
+    double histogramMin = -100.0;
+    double binWidth = 1.0;
+    std::vector<long> histogram;        // Nombre de points par classe
+    ZoneStatistics all;                 // Toute la salle
+    std::vector<ZoneStatistics> zones;  // Alignées sur CoverageOptions::zones
+
+    explicit CoverageStatistics(const CoverageOptions& options = CoverageOptions());
+
+    void merge(const CoverageStatistics& other);
+
+    /**
+     * Percentile de la puissance (p entre 0 et 100), interpolé dans la classe de l'histogramme
+     * Précis à binWidth près
+     */
+    double percentile(double p) const;
+
+    // Écrit l'histogramme au format CSV (borne basse de la classe, nombre de points)
+    bool exportHistogram(const std::string& filename) const;
+};
+
+/**
+ * Calcule les statistiques de couverture sans construire ni lire powerMap
+ * Chaque tuile est réduite dans son propre accumulateur pendant le calcul parallèle, puis les
+ * accumulateurs sont fusionnés dans l'ordre des tuiles (résultat indépendant du nombre de threads) :
+ * la mémoire est en O(tuiles), quelle que soit la taille de la carte (sauf moteur polaire préparé
+ * en plusieurs groupes d'émetteurs : le maximum des groupes est gardé point par point)
+ */
+CoverageStatistics computeCoverageStatistics(const Room& room, const CoverageOptions& options);
+
+/**
+ * Mêmes statistiques, lues sur une carte déjà calculée et marquée (markObstaclesOnPowerMap)
+ */
+CoverageStatistics coverageStatisticsFromMap(PowerMapReader& reader, const CoverageOptions& options);
+
+#endif // COVERAGE_HPP
@@ -4,6 +4,8 @@
 #include <SDL.h>
 #include <vector>
 #include "room.hpp"
+#include "map_reader.hpp"
+#include "throughput.hpp"
 #include <vector>
 
 #include "../lib/SDL2_ttf/include/SDL_ttf.h"
@@ -12,10 +14,35 @@ std::vector<std::vector<double>> loadCSV(const std::string& filename);
 
 SDL_Color dBmToColor(double power, double min_power, double max_power);
 
+// Couleur d'un débit (Mb/s) : même palette que dBmToColor de 0 à max_rate, gris foncé si non servi
+SDL_Color throughputToColor(double rate, double max_rate);
+
 int displaying(Room* room);
 
 int handlepowerMap(Room* room, SDL_Renderer* renderer);
 
+// Dessine une carte lue ligne par ligne (carte en mémoire ou par tuiles), un point sur step
+// dans chaque direction
+int drawPowerMap(PowerMapReader& reader, SDL_Renderer* renderer, int step = 1);
+
+/**
+ * Affiche une carte en lecture seule, lue par PowerMapReader (typiquement une TiledMap trop
+ * grande pour powerMap) : réduite pour tenir dans MAX_VIEW_WIDTH x MAX_VIEW_HEIGHT, un clic
+ * affiche la puissance du point. Échap ou fermeture de la fenêtre pour quitter
+ */
+int displayingMap(PowerMapReader& reader);
+
+// Cartes de desserte gardées entre deux affichages des débits, pour la scène de hash sceneHash
+struct ServingMapsCache {
+    ServingMaps maps;
+    uint64_t sceneHash = 0;
+    bool valid = false;
+};
+
+// Dessine la carte des débits attendus (SINR -> débit par la table), obstacles marqués en noir.
+// Les cartes de desserte ne sont recalculées que si la scène a changé depuis le dernier appel
+int drawThroughputMap(Room* room, const ThroughputTable& table, ServingMapsCache& cache, SDL_Renderer* renderer);
+
 SDL_Texture* renderText(SDL_Renderer* renderer, TTF_Font* font, const char* text, SDL_Color textColor);
 
 #endif // MYSDL_HPP
\ No newline at end of file
@@ -2,8 +2,13 @@
 #define EMMITTER_HPP
 
 
+// Résolution par défaut de la grille, en unités par mètre (voir PropagationModel::resolution)
 #define RESOLUTION_FACTOR 100
 
+// Version du modèle de propagation, à incrémenter à chaque changement de calcul
+// (invalide les cartes mises en cache sur disque)
+#define PROPAGATION_MODEL_VERSION 1
+
 
 // Émetteur Wi-Fi
 class Emitter {
@@ -12,8 +17,19 @@ class Emitter {
     
         Emitter(double x, double y, double power, double frequency);
     
-        // Calcule la puissance reçue à une distance donnée (sans obstacles)
+        // Calcule la puissance reçue à une distance donnée (sans obstacles, modèle par défaut : espace libre)
         double computePower(double x_target, double y_target) const;
+
+        // Perte ne dépendant que de la fréquence : 20·log10(f) + 20·log10(4π/c)
+        static double frequencyLoss(double frequency);
+
+        /**
+         * Gain de distance -20·log10(d) entre une position d'émission et un point (d en mètres),
+         * pour le modèle par défaut (voir PropagationModel::distanceGain)
+         * computePower vaut power - frequencyLoss(frequency) + gain
+         * @return false en champ proche (d < 1 mm), où computePower renvoie power tel quel
+         */
+        static bool distanceGain(double emitter_x, double emitter_y, double x_target, double y_target, double& gain);
     
         // Getters
         double getX() const;
@@ -0,0 +1,71 @@
+#ifndef FLOORPLAN_HPP
+#define FLOORPLAN_HPP
+
+#include <string>
+#include <vector>
+#include <map>
+#include "room.hpp"
+
+/**
+ * Paramètres d'import d'un plan vectoriel (SVG ou DXF)
+ * Les longueurs sont exprimées en unités de grille (1 / RESOLUTION_FACTOR mètre)
+ */
+struct FloorplanImportOptions {
+    double scale = 1.0;             // Facteur de conversion unités du fichier -> unités de grille
+    double offsetX = 0.0;           // Translation appliquée après mise à l'échelle
+    double offsetY = 0.0;
+    bool flipY = false;             // Inverser l'axe Y (les DXF ont l'axe Y vers le haut)
+    double thickness = 10.0;        // Épaisseur par défaut si le fichier n'en donne pas
+    double attenuation = 5.0;       // Atténuation par défaut (dB)
+    std::map<std::string, double> layerAttenuation; // Atténuation par calque (DXF) ou classe (SVG)
+    double minLength = 1.0;         // Longueur minimale d'un mur après fusion (sous-pixel = supprimé)
+    double collinearTolerance = 0.5;// Écart perpendiculaire toléré entre segments colinéaires
+    double angleTolerance = 1e-3;   // Écart angulaire toléré (radians)
+    double gapTolerance = 0.5;      // Espace maximal comblé entre deux segments bout à bout
+};
+
+/**
+ * Segment de mur intermédiaire, avant création des obstacles
+ */
+struct WallSegment {
+    double x1, y1, x2, y2;
+    double thickness;
+    double attenuation;
+};
+
+/**
+ * Bilan d'un import : nombre d'obstacles avant et après simplification
+ */
+struct FloorplanImportStats {
+    int segmentsRead = 0;       // Segments lus dans le fichier (un Mur chacun sans simplification)
+    int segmentsMerged = 0;     // Segments absorbés par une fusion
+    int sliversDropped = 0;     // Segments sous-pixel supprimés
+    int obstaclesAdded = 0;     // Obstacles effectivement ajoutés à la salle
+    int mursDroits = 0;         // Dont murs verticaux/horizontaux (MurDroit)
+    int mursObliques = 0;       // Dont murs quelconques (Mur)
+};
+
+// Lecture brute des segments d'un fichier SVG (line, polyline, polygon, rect, path M/L/H/V/Z)
+std::vector<WallSegment> readSVGSegments(const std::string& filename, const FloorplanImportOptions& options);
+
+// Lecture brute des segments d'un fichier DXF (LINE, LWPOLYLINE, POLYLINE/VERTEX)
+std::vector<WallSegment> readDXFSegments(const std::string& filename, const FloorplanImportOptions& options);
+
+/**
+ * Fusionne les segments colinéaires et adjacents de même atténuation et même épaisseur,
+ * puis supprime les segments plus courts que options.minLength
+ */
+std::vector<WallSegment> simplifySegments(const std::vector<WallSegment>& segments,
+                                          const FloorplanImportOptions& options,
+                                          FloorplanImportStats& stats);
+
+/**
+ * Importe un plan SVG ou DXF (selon l'extension) dans la salle
+ * Les segments axés deviennent des MurDroit, les autres des Mur
+ * @return Bilan de l'import (obstacles avant/après fusion) ; segmentsRead est nul si le fichier
+ *         est absent, de format inconnu ou ne contient aucun segment lisible (échec de l'import)
+ */
+FloorplanImportStats importFloorplan(Room& room, const std::string& filename,
+                                     const FloorplanImportOptions& options = FloorplanImportOptions());
+
+#endif // FLOORPLAN_HPP
@@ -0,0 +1,45 @@
+#ifndef MAP_CACHE_HPP
+#define MAP_CACHE_HPP
+
+#include <string>
+#include "room.hpp"
+
+/**
+ * Cache disque des cartes calculées, adressé par le hash de la scène
+ * Chaque entrée est un fichier binaire (Room::exportToBinary) nommé d'après Room::sceneHash(),
+ * une scène inchangée est donc rechargée au lieu d'être recalculée
+ */
+class MapCache {
+public:
+    /**
+     * @param directory Répertoire du cache (créé si nécessaire)
+     */
+    explicit MapCache(const std::string& directory);
+
+    // Chemin du fichier de cache correspondant à la scène
+    std::string entryPath(const Room& room) const;
+
+    /**
+     * Charge la carte de la scène depuis le cache
+     * @return true si une entrée valide existe (et contient les couches par émetteur si demandées)
+     */
+    bool load(Room& room) const;
+
+    /**
+     * Enregistre la carte courante de la salle dans le cache
+     * L'écriture passe par un fichier temporaire propre au processus et au thread, renommé
+     * ensuite : jamais d'entrée partielle, même avec plusieurs écrivains de la même entrée
+     */
+    bool store(const Room& room) const;
+
+    /**
+     * Charge la carte depuis le cache ou, à défaut, la calcule puis l'enregistre
+     * @return true si la carte provient du cache
+     */
+    bool computeSignalMap(Room& room) const;
+
+private:
+    std::string directory;
+};
+
+#endif // MAP_CACHE_HPP
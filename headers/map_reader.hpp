@@ -0,0 +1,108 @@
+#ifndef MAP_READER_HPP
+#define MAP_READER_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Lecture d'une carte de puissance ligne par ligne, quel que soit son stockage
+ * (powerMap en mémoire ou carte par tuiles sur disque). Les points obstacles valent -555
+ * L'affichage, l'export CSV et les statistiques passent par cette interface
+ */
+class PowerMapReader {
+public:
+    virtual ~PowerMapReader() {}
+
+    virtual int mapWidth() const = 0;
+    virtual int mapHeight() const = 0;
+
+    /**
+     * Copie les points [x0, x1) de la ligne y dans out
+     */
+    virtual void readRow(int y, int x0, int x1, double* out) = 0;
+};
+
+/**
+ * Lecture d'une carte gardée en mémoire (Room::powerMap)
+ */
+class InMemoryMapReader : public PowerMapReader {
+public:
+    explicit InMemoryMapReader(const std::vector<std::vector<double>>& map) : map(map) {}
+
+    int mapWidth() const override { return map.empty() ? 0 : static_cast<int>(map[0].size()); }
+    int mapHeight() const override { return static_cast<int>(map.size()); }
+    void readRow(int y, int x0, int x1, double* out) override;
+
+private:
+    const std::vector<std::vector<double>>& map;
+};
+
+/**
+ * Codage d'une puissance en centièmes de dBm sur 16 bits (précision 0,01 dB sur ±327 dBm)
+ * OBSTACLE est réservé au marquage des obstacles (-555 dans les cartes en doubles)
+ */
+struct QuantizedPower {
+    static constexpr int16_t OBSTACLE = INT16_MIN;
+
+    static int16_t encode(double power) {
+        if (power == -555) return OBSTACLE;
+        const double centi = std::nearbyint(power * 100.0);
+        return static_cast<int16_t>(std::min(32767.0, std::max(-32767.0, centi)));
+    }
+
+    static double decode(int16_t value) {
+        return value == OBSTACLE ? -555.0 : value / 100.0;
+    }
+};
+
+/**
+ * Lecture d'une carte quantifiée (Room::quantizedMap), décodée à la volée
+ */
+class QuantizedMapReader : public PowerMapReader {
+public:
+    QuantizedMapReader(const std::vector<int16_t>& map, int width, int height)
+    : map(map), width(width), height(height) {}
+
+    int mapWidth() const override { return width; }
+    int mapHeight() const override { return height; }
+    void readRow(int y, int x0, int x1, double* out) override;
+
+private:
+    const std::vector<int16_t>& map;
+    int width, height;
+};
+
+/**
+ * Exporte une carte au format CSV, une ligne de la carte par ligne de fichier
+ * @return true si l'écriture a réussi
+ */
+bool exportMapToCSV(PowerMapReader& reader, const std::string& filename);
+
+/**
+ * Écart entre une carte et une carte de référence de même taille (points obstacles exclus)
+ */
+struct MapComparison {
+    // Écart au-delà duquel un point a basculé (au moins un obstacle jugé autrement, bord
+    // d'ombre) : la moitié du pas de 0.1 dB des sorties, bien au-dessus des erreurs d'arrondi
+    static constexpr double FLIP_THRESHOLD = 0.05;
+
+    long points = 0;        // Points comparés
+    long differing = 0;     // Points dont l'écart dépasse la tolérance
+    long flipped = 0;       // Points dont l'écart dépasse FLIP_THRESHOLD
+    double maxError = 0.0;  // Écart absolu maximal (dB)
+    double meanError = 0.0; // Écart absolu moyen (dB)
+
+    double differingFraction() const { return points > 0 ? static_cast<double>(differing) / points : 0.0; }
+    double flippedFraction() const { return points > 0 ? static_cast<double>(flipped) / points : 0.0; }
+};
+
+/**
+ * Compare une carte à une référence (typiquement le moteur exact)
+ * @param tolerance Écart en dessous duquel deux points sont jugés identiques
+ */
+MapComparison compareMaps(PowerMapReader& reference, PowerMapReader& candidate, double tolerance = 1e-9);
+
+#endif // MAP_READER_HPP
@@ -7,6 +7,19 @@
 #include <iostream>
 #include <ostream>
 
+class Obstacle;
+
+/**
+ * Invariants d'un obstacle pour un émetteur fixé, calculés une fois par Obstacle::prepare
+ * puis réutilisés pour chaque point par les variantes préparées de isBlocking / blockingMask
+ */
+struct PreparedObstacle {
+    const Obstacle* obstacle;
+    double emitter_x, emitter_y;
+    bool emitterInside;  // Émetteur dans l'obstacle : tout rayon est bloqué
+    double terms[3];     // Termes propres au type (Mur : projections de l'émetteur ; MurDroit axé :
+                         // écarts des deux faces à l'émetteur en travers du mur ; cercle : fx, fy, c)
+};
 
 /**
  * Classe représentant un obstacle dans une simulation de propagation de signal.
@@ -39,6 +52,30 @@ class Obstacle {
         // Vérifie si l'obstacle bloque la ligne entre un émetteur et un point
         virtual bool isBlocking(double x, double y, double emitter_x, double emitter_y) const = 0;
 
+        /**
+        * Prépare l'obstacle pour un émetteur : tout ce qui ne dépend que de sa position
+        * Implémentation par défaut : position et test d'inclusion de l'émetteur
+        */
+        virtual void prepare(double emitter_x, double emitter_y, PreparedObstacle& prepared) const;
+
+        // isBlocking pour l'émetteur préparé (même résultat)
+        virtual bool isBlocking(double x, double y, const PreparedObstacle& prepared) const;
+
+        // Nombre de rayons (voies) d'un paquet pour blockingMask
+        static constexpr int PACKET_SIZE = 8;
+
+        /**
+        * isBlocking pour un paquet de PACKET_SIZE rayons partant du même émetteur (préparé)
+        * Structure de tableaux : une voie par point, mask[i] = 1.0 si bloqué, 0.0 sinon, à
+        * multiplier par l'atténuation. Les surcharges calculent les voies sans branche (boucles
+        * vectorisables) et donnent exactement le même résultat que isBlocking
+        * Implémentation par défaut : isBlocking voie par voie
+        */
+        virtual void blockingMask(const double* xs, const double* ys, const PreparedObstacle& prepared, double* mask) const;
+
+        // Même test en simple précision (Precision::Float) : peut différer de isBlocking aux bords
+        virtual void blockingMask(const float* xs, const float* ys, const PreparedObstacle& prepared, float* mask) const;
+
         /**
         * Calcule la boîte englobante étendue de l'obstacle
         * @param[out] min_x,min_y Coin inférieur gauche de la zone d'influence
@@ -46,7 +83,24 @@ class Obstacle {
         */
         virtual void getExpandedBounds(double& min_x, double& min_y, double& max_x, double& max_y) const = 0;
 
+        /**
+        * Vérifie si la forme de l'obstacle recouvre, même en partie, un rectangle aligné sur les axes
+        * (bords compris, même tolérance EPSILON que isPointInside)
+        * @param min_x,min_y Coin inférieur gauche du rectangle
+        * @param max_x,max_y Coin supérieur droit du rectangle
+        */
+        virtual bool overlapsBox(double min_x, double min_y, double max_x, double max_y) const = 0;
+
+        /**
+        * Écrit une description canonique de l'obstacle (type et paramètres, sur une ligne)
+        * Sert au hachage des scènes : deux obstacles identiques donnent la même description
+        */
+        virtual void describe(std::ostream& os) const = 0;
+
         double getAttenuation() const { return attenuation; }
+
+        // Modifie l'atténuation (calibration d'un matériau)
+        void setAttenuation(double value) { attenuation = value; }
         
 };
 
@@ -89,6 +143,10 @@ class Mur : public Obstacle{
 
         bool satTest(double e_axe, double e_perp, double p_axe, double p_perp, double min_a, double max_a, double min_p, double max_p) const;
 
+        // Corps de blockingMask, dans le type des calculs (double ou float)
+        template <typename Scalar>
+        void packetMask(const Scalar* xs, const Scalar* ys, const PreparedObstacle& prepared, Scalar* mask) const;
+
 
     public :
         Mur(double x1, double y1, double x2, double y2, double thickness, double attenuation);
@@ -104,6 +162,9 @@ class Mur : public Obstacle{
         // Vérifier si un point est à l'intérieur de l'obstacle (avec épaisseur)
         bool isPointInside(double px, double py) const override;
 
+        // Axes séparateurs : ceux du rectangle (boîte englobante) puis ceux du mur
+        bool overlapsBox(double min_x, double min_y, double max_x, double max_y) const override;
+
         /**
         * Algorithme de Liang-Barsky pour l'intersection segment-rectangle
         * @param rect_x1,rect_y1 Coin inférieur gauche
@@ -114,6 +175,17 @@ class Mur : public Obstacle{
 
         bool isBlocking(double x, double y, double emitter_x, double emitter_y) const;
 
+        // Projections de l'émetteur dans le repère du mur
+        void prepare(double emitter_x, double emitter_y, PreparedObstacle& prepared) const override;
+
+        bool isBlocking(double x, double y, const PreparedObstacle& prepared) const override;
+
+        // Test SAT de satTest, voie par voie
+        void blockingMask(const double* xs, const double* ys, const PreparedObstacle& prepared, double* mask) const override;
+        void blockingMask(const float* xs, const float* ys, const PreparedObstacle& prepared, float* mask) const override;
+
+        void describe(std::ostream& os) const override;
+
 };
 
 
@@ -122,14 +194,50 @@ class MurDroit:public Mur{
     
     public:
 
+        /**
+        * Orientation reconnue à la construction (tolérance 0.001, comme l'import de plans)
+        * Un mur OBLIQUE n'est pas un mur droit : il est traité entièrement comme un Mur
+        */
+        enum Orientation { VERTICAL, HORIZONTAL, OBLIQUE };
+
         MurDroit(double x1, double y1, double x2, double y2, double thickness, double attenuation);
 
+        Orientation getOrientation() const { return orientation; }
+
     
         // Vérifier si un point est à l'intérieur de l'obstacle (avec épaisseur)
         bool isPointInside(double px, double py) const override;
 
+        // Intersection de deux rectangles alignés (version de Mur pour un mur oblique)
+        bool overlapsBox(double min_x, double min_y, double max_x, double max_y) const override;
+
         // Optimisation: intersection entre ligne (émetteur-point) et obstacle avec épaisseur
         bool isBlocking(double x, double y, double emitter_x, double emitter_y) const override;
+
+        // Écarts des faces à l'émetteur en travers du mur (préparation de Mur pour un mur oblique)
+        void prepare(double emitter_x, double emitter_y, PreparedObstacle& prepared) const override;
+
+        bool isBlocking(double x, double y, const PreparedObstacle& prepared) const override;
+
+        // Tests par faces de isBlocking, sans branche (version de Mur pour un mur oblique)
+        void blockingMask(const double* xs, const double* ys, const PreparedObstacle& prepared, double* mask) const override;
+        void blockingMask(const float* xs, const float* ys, const PreparedObstacle& prepared, float* mask) const override;
+
+        void describe(std::ostream& os) const override;
+
+    private:
+
+        // Tests par faces d'un mur vertical (en x = position) ou horizontal (en y = position)
+        bool isBlockingVertical(double x, double y, double emitter_x, double emitter_y) const;
+        bool isBlockingHorizontal(double x, double y, double emitter_x, double emitter_y) const;
+
+        // Corps de blockingMask pour un mur axé, dans le type des calculs (double ou float)
+        template <typename Scalar>
+        void packetMask(const Scalar* xs, const Scalar* ys, const PreparedObstacle& prepared, Scalar* mask) const;
+
+        Orientation orientation;
+        double position;    // x du mur vertical, y du mur horizontal
+        double from, to;    // Étendue le long du mur, from <= to (extrémités dans n'importe quel ordre)
 };
 
 
@@ -147,16 +255,35 @@ class obstacleCirculaire : public Obstacle {
 
         void getExpandedBounds(double& min_x, double& min_y, double& max_x, double& max_y) const;
 
+        // Distance du centre au point du rectangle le plus proche
+        bool overlapsBox(double min_x, double min_y, double max_x, double max_y) const override;
+
         /*
         * Vérifie l'intersection avec un obstacle circulaire (logique interne)
         */
         // Optimisation: intersection entre ligne (émetteur-point) et obstacle avec épaisseur
         bool isBlocking(double x, double y, double emitter_x, double emitter_y) const override;
 
+        // Vecteur émetteur -> centre (fx, fy) et terme constant c de l'équation d'intersection
+        void prepare(double emitter_x, double emitter_y, PreparedObstacle& prepared) const override;
+
+        bool isBlocking(double x, double y, const PreparedObstacle& prepared) const override;
+
+        // Test du discriminant, voie par voie
+        void blockingMask(const double* xs, const double* ys, const PreparedObstacle& prepared, double* mask) const override;
+        void blockingMask(const float* xs, const float* ys, const PreparedObstacle& prepared, float* mask) const override;
+
+        void describe(std::ostream& os) const override;
+
         double getCenterX() const { return cx; }
         double getCenterY() const { return cy; }
         double getRadius() const { return radius; }
-        
+
+    private:
+
+        // Corps de blockingMask, dans le type des calculs (double ou float)
+        template <typename Scalar>
+        void packetMask(const Scalar* xs, const Scalar* ys, const PreparedObstacle& prepared, Scalar* mask) const;
 };
 
 
@@ -0,0 +1,54 @@
+#ifndef OCCLUSION_ENGINE_HPP
+#define OCCLUSION_ENGINE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Obstacle;
+
+/**
+ * Moteur d'occlusion préparé pour une salle (voir Room::prepareEngine)
+ * Construit une fois par calcul, puis interrogé en parallèle point par point : occlusion
+ * doit être sans effet de bord, l'état de travail passant par scratch
+ */
+class OcclusionEngine {
+public:
+    virtual ~OcclusionEngine() {}
+
+    /**
+     * Atténuation totale des obstacles entre un émetteur de la salle et le centre d'un pixel
+     * @param emitter Indice de l'émetteur dans Room::emitters
+     * @param scratch Tampon de travail, réutilisé d'un appel à l'autre par le même thread
+     */
+    virtual double occlusion(size_t emitter, int x, int y, std::vector<uint32_t>& scratch) const = 0;
+
+    // Émetteurs préparés : indices firstEmitter .. endEmitter - 1 de Room::emitters (tous par
+    // défaut ; voir Room::prepareEngineGroup)
+    size_t firstEmitter = 0;
+    size_t endEmitter = SIZE_MAX;
+};
+
+/**
+ * Secteur angulaire couvert par un obstacle vu depuis un émetteur, pour les moteurs qui
+ * découpent le plan en directions régulières autour de l'émetteur (direction i d'angle
+ * i·2π/directions). Les boîtes englobantes sont élargies d'un pixel ; un émetteur dans la
+ * boîte voit tout le tour
+ */
+struct ObstacleSector {
+    int first, count;                  // Directions first .. first + count - 1 (modulo le nombre de directions)
+    double nearRadius, farRadius;      // Distances de l'émetteur à la boîte et à son coin le plus lointain
+    double min_x, min_y, max_x, max_y; // Boîte englobante élargie
+};
+
+std::vector<ObstacleSector> obstacleSectors(const std::vector<const Obstacle*>& obstacles,
+                                            double emitter_x, double emitter_y, int directions);
+
+/**
+ * Obstacles candidats de chaque direction, dans l'ordre des obstacles
+ * Les candidats de la direction i sont candidates[start[i]] .. candidates[start[i+1] - 1]
+ */
+void sectorCandidates(const std::vector<ObstacleSector>& sectors, int directions,
+                      std::vector<uint32_t>& start, std::vector<uint32_t>& candidates);
+
+#endif // OCCLUSION_ENGINE_HPP
@@ -0,0 +1,46 @@
+#ifndef OPTIMIZER_HPP
+#define OPTIMIZER_HPP
+
+#include <vector>
+#include "room.hpp"
+
+/**
+ * Paramètres de la recherche de positions d'émetteurs
+ */
+struct PlacementOptions {
+    int emitterCount = 1;           // Nombre d'émetteurs à placer
+    double power = 20.0;            // Puissance des émetteurs placés (dBm)
+    double frequency = 2.4e9;       // Fréquence des émetteurs placés (Hz)
+    double threshold = -67.0;       // Seuil de couverture (dBm)
+    int downsample = 10;            // Pas de la grille grossière d'évaluation (pixels)
+    int candidateStep = 2;          // Un candidat tous les candidateStep points de la grille grossière
+    int iterations = 2000;          // Itérations du recuit simulé (0 = glouton seul)
+    double temperature = 0.01;      // Température initiale (en fraction de couverture)
+    unsigned seed = 1;              // Graine du générateur aléatoire
+    int threads = 0;                // Threads d'évaluation (0 = tous les cœurs)
+};
+
+/**
+ * Résultat de la recherche
+ */
+struct PlacementResult {
+    std::vector<Emitter> emitters;  // Émetteurs placés (coordonnées de la grille complète)
+    double coverage = 0.0;          // Fraction des points libres au-dessus du seuil (grille grossière)
+    long evaluations = 0;           // Nombre de configurations évaluées
+    double seconds = 0.0;
+};
+
+/**
+ * Cherche les positions d'émetteurs qui maximisent la couverture au-dessus du seuil,
+ * en complément des émetteurs déjà présents dans la salle
+ *
+ * La couverture n'est évaluée que sur une grille grossière. La couche de chaque position
+ * candidate est calculée une seule fois (en parallèle) puis réduite à l'ensemble des points
+ * qu'elle couvre : un point est couvert si au moins un émetteur y dépasse le seuil, la
+ * couverture d'une configuration est donc l'union de ces ensembles, sans aucun appel à
+ * computeSignalMap. Placement glouton, puis recuit simulé dont les mouvements proposés
+ * sont évalués en parallèle
+ */
+PlacementResult optimizePlacement(const Room& room, const PlacementOptions& options);
+
+#endif // OPTIMIZER_HPP
@@ -0,0 +1,41 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Nombre de cœurs disponibles (au moins 1)
+inline int hardwareThreads() {
+    const unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : static_cast<int>(n);
+}
+
+/**
+ * Exécute task(i) pour chaque i de [0, count) sur au plus `threads` threads
+ * Les indices sont distribués dynamiquement : un thread qui termine prend l'indice suivant
+ * @param threads Nombre de threads (0 = tous les cœurs)
+ */
+template <typename Task>
+void parallelFor(int count, int threads, Task task) {
+    if (threads <= 0) threads = hardwareThreads();
+    threads = std::min(threads, count);
+    if (threads <= 1) {
+        for (int i = 0; i < count; i++) task(i);
+        return;
+    }
+
+    std::atomic<int> next(0);
+    auto worker = [&]() {
+        for (int i = next++; i < count; i = next++) task(i);
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (int t = 1; t < threads; t++) pool.emplace_back(worker);
+    worker(); // Le thread appelant participe
+    for (auto& th : pool) th.join();
+}
+
+#endif // PARALLEL_HPP
@@ -0,0 +1,73 @@
+#ifndef POLAR_ENGINE_HPP
+#define POLAR_ENGINE_HPP
+
+#include <cstdint>
+#include <vector>
+#include "room.hpp"
+#include "occlusion_engine.hpp"
+
+/**
+ * Moteur par rééchantillonnage polaire : pour chaque émetteur, les obstacles sont échantillonnés
+ * (isPointInside) sur une grille polaire centrée sur l'émetteur, de pas SAMPLE_SPACING en
+ * distance et au bout le plus lointain en angle. Chaque obstacle ajoute son atténuation au
+ * premier échantillon où une direction le rencontre, et une somme préfixe le long de chaque
+ * direction donne l'atténuation cumulée depuis l'émetteur. Un pixel lit l'échantillon polaire
+ * le plus proche : aucun test exact, le coût ne dépend plus que de la surface des obstacles.
+ *
+ * Approché aux bords des obstacles (à un échantillon près) et pour les obstacles plus fins que
+ * le pas : l'écart au calcul exact se mesure avec compareMaps (batch --verify).
+ * Les cumuls sont gardés en centièmes de dB sur 16 bits signés, saturés à ±327 dB (au-delà de
+ * l'écart entre la puissance d'un émetteur et le plancher) : les atténuations négatives s'y cumulent.
+ *
+ * Mémoire : pour un rayon R (pixels), 2πR/SAMPLE_SPACING directions de R/SAMPLE_SPACING
+ * échantillons de 2 octets, soit environ 16πR² octets par émetteur (50 Mo pour R = 1000, 4 Go
+ * pour 50 émetteurs dans une salle de 1000 x 800). R est la distance au coin le plus lointain de
+ * la salle, bornée par la portée de l'émetteur (PropagationModel::range au plancher) quand aucun
+ * obstacle n'a d'atténuation négative : au-delà, la lecture est celle du dernier échantillon, sans
+ * effet sur la carte puisque l'émetteur y reste sous le plancher.
+ * Les grilles des émetteurs préparés sont toutes construites d'avance : Room::computeSignalMap
+ * prépare le moteur par groupes d'émetteurs tenant dans GROUP_BUDGET (voir groupEnd), de même que
+ * les cartes par tuiles et les statistiques en flux.
+ */
+class PolarEngine : public OcclusionEngine {
+public:
+    static constexpr double SAMPLE_SPACING = 0.5; // Pas radial, et écart maximal entre directions (pixels)
+    static constexpr size_t GROUP_BUDGET = size_t(1) << 30; // Grilles d'un groupe d'émetteurs (octets)
+
+    /**
+     * Prépare les émetteurs first .. end - 1 (bornés au nombre d'émetteurs de la salle)
+     * @param threads Threads utilisés pour échantillonner les directions (0 = tous les cœurs)
+     */
+    PolarEngine(const Room& room, int threads, size_t first = 0, size_t end = SIZE_MAX);
+
+    /**
+     * Fin du groupe d'émetteurs commençant à first dont les grilles tiennent dans GROUP_BUDGET
+     * (au moins un émetteur)
+     */
+    static size_t groupEnd(const Room& room, size_t first);
+
+    double occlusion(size_t emitter, int x, int y, std::vector<uint32_t>& scratch) const override;
+
+    // Taille de la grille polaire d'un émetteur (directions x échantillons radiaux)
+    size_t sampleCount(size_t emitter) const { return grids[emitter - firstEmitter].totals.size(); }
+
+private:
+    struct PolarGrid {
+        double x, y;
+        int directions;
+        int radii;                      // Échantillons par direction, à 0, SAMPLE_SPACING, ...
+        double step;                    // Angle entre deux directions
+        std::vector<int16_t> totals;    // Atténuation cumulée (centièmes de dB), direction par direction
+    };
+
+    // Rayon de la grille d'un émetteur de la salle, et taille de ses cumuls (directions x échantillons)
+    static double gridRadius(const Room& room, size_t emitter);
+    static void gridShape(double radius, int& directions, int& radii);
+
+    void buildGrid(PolarGrid& grid, double radius, int threads) const;
+
+    std::vector<const Obstacle*> obstacles;
+    std::vector<PolarGrid> grids;
+};
+
+#endif // POLAR_ENGINE_HPP
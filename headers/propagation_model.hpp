@@ -0,0 +1,81 @@
+#ifndef PROPAGATION_MODEL_HPP
+#define PROPAGATION_MODEL_HPP
+
+#include <string>
+#include "emitter.hpp"
+
+/**
+ * Modèle d'affaiblissement en fonction de la distance d (en mètres)
+ * La perte totale vaut frequencyLoss(f) + perte de distance : le terme de fréquence est celui
+ * de l'espace libre à 1 m, ce qui garde la décomposition des couches (voir EmitterLayer)
+ */
+enum class PathLoss {
+    FreeSpace,   // 20·log10(d)
+    LogDistance, // 10·n·log10(d)
+    DualSlope    // 10·n·log10(d) jusqu'à la cassure, puis pente 10·n2·log10(d / cassure)
+};
+
+// Précision des calculs du moteur exact : noyau de puissance et tests d'obstacles (les cartes restent en double)
+enum class Precision {
+    Double,
+    Float   // Voies deux fois plus larges ; écarts aux bords d'ombre, bornés par make verify
+};
+
+// Nom d'une précision ("double", "float"), tel qu'écrit dans les fichiers de scène
+const char* precisionName(Precision precision);
+
+// @return false si le nom est inconnu
+bool parsePrecision(const std::string& name, Precision& precision);
+
+// Nom d'un modèle ("freespace", "logdistance", "dualslope"), tel qu'écrit dans les fichiers de scène
+const char* pathLossName(PathLoss pathLoss);
+
+// @return false si le nom est inconnu
+bool parsePathLoss(const std::string& name, PathLoss& pathLoss);
+
+/**
+ * Paramètres du calcul de puissance sans obstacles d'une salle
+ * Par défaut : espace libre, RESOLUTION_FACTOR unités de grille par mètre (Emitter::computePower)
+ */
+struct PropagationModel {
+    PathLoss pathLoss = PathLoss::FreeSpace;
+    double exponent = 2.0;              // LogDistance, et DualSlope avant la cassure
+    double breakpoint = 10.0;           // DualSlope : distance de cassure (m)
+    double farExponent = 3.5;           // DualSlope : exposant au-delà de la cassure
+    int resolution = RESOLUTION_FACTOR; // Unités de grille par mètre
+
+    // @return false si les paramètres sont invalides (exposants ou cassure non positifs, résolution < 1)
+    bool isValid() const;
+
+    // Puissance reçue d'un émetteur en un point, sans obstacles (équivalent scalaire du noyau)
+    double power(const Emitter& emitter, double x_target, double y_target) const;
+
+    /**
+     * Gain de distance (opposé de la perte de distance) entre une position d'émission et un point
+     * @return false en champ proche (d < 1 mm), où la puissance reçue vaut celle de l'émetteur
+     */
+    bool distanceGain(double emitter_x, double emitter_y, double x_target, double y_target, double& gain) const;
+
+    /**
+     * Portée d'un émetteur : distance (unités de grille) au-delà de laquelle sa puissance sans
+     * obstacles est sous floor (la perte croît avec la distance pour les trois modèles)
+     * Arrondie au-dessus d'un pixel : un point plus lointain est sous floor dans les deux précisions
+     */
+    double range(const Emitter& emitter, double floor) const;
+};
+
+/**
+ * Noyau de puissance sans obstacles d'un émetteur sur count points :
+ * out[i] = power - (perte de distance + frequencyLoss(frequency)), ou power en champ proche
+ */
+using PowerKernel = void (*)(const PropagationModel& model, const Emitter& emitter,
+                             const double* xs, const double* ys, int count, double* out);
+
+/**
+ * Instanciation du noyau spécialisée à la compilation pour le modèle, la précision et la
+ * résolution (10, 50 ou 100 ; les autres résolutions passent par une instanciation générique).
+ * À choisir une fois par calcul, puis appeler pour chaque ligne ou paquet de points
+ */
+PowerKernel selectPowerKernel(const PropagationModel& model, Precision precision);
+
+#endif // PROPAGATION_MODEL_HPP
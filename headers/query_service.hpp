@@ -0,0 +1,81 @@
+#ifndef QUERY_SERVICE_HPP
+#define QUERY_SERVICE_HPP
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "room.hpp"
+
+/**
+ * Service de requêtes sur des scènes gardées en mémoire (cartes et couches par émetteur)
+ *
+ * Protocole texte, une requête par ligne, une réponse par ligne ("OK ..." ou "ERR message") :
+ *   LOAD nom fichier_scene            -> OK hash largeur hauteur
+ *   UNLOAD nom                        -> OK
+ *   SCENES                            -> OK nom1 nom2 ...
+ *   POINT nom x y                     -> OK puissance | OK OBSTACLE
+ *   REGION nom x0 y0 x1 y1            -> OK min max moyenne nombre_de_points
+ *   TILE nom tx ty                    -> OK x0 y0 x1 y1 v v v ... (ligne par ligne)
+ *   EDIT nom ADD_EMITTER x y puissance frequence
+ *   EDIT nom MOVE_EMITTER index x y
+ *   EDIT nom DELETE_EMITTER x y
+ *   EDIT nom ADD MUR|MURDROIT|CERCLE ... (syntaxe des fichiers de scène)
+ *   EDIT nom DELETE_OBSTACLE x1 y1 x2 y2 -> OK hash
+ *
+ * Les lectures travaillent sur un instantané immuable de la scène : une modification
+ * est appliquée sur une copie puis publiée, sans jamais bloquer les lecteurs.
+ * Seules les couches touchées par la modification sont recalculées ; les autres sont partagées
+ * entre la copie et l'instantané précédent, sans être copiées (voir Room::emitterLayers).
+ * Une modification pendant laquelle la scène est déchargée ou rechargée (UNLOAD, LOAD du même
+ * nom) n'est pas publiée et répond ERR.
+ */
+class QueryService {
+public:
+    /**
+     * @param cacheDirectory Cache disque des cartes (vide = pas de cache)
+     * @param threads Threads de calcul par scène (0 = tous les cœurs)
+     */
+    explicit QueryService(const std::string& cacheDirectory = "", int threads = 0);
+
+    // Traite une requête (appelable depuis plusieurs threads à la fois)
+    std::string handle(const std::string& request);
+
+private:
+    // Obstacles d'une scène, partagés par tous ses instantanés
+    struct ObstaclePool {
+        std::vector<std::unique_ptr<Obstacle>> obstacles;
+    };
+
+    // État publié d'une scène, jamais modifié après publication
+    struct Snapshot {
+        Room room;
+        std::shared_ptr<ObstaclePool> pool;
+    };
+
+    struct Scene {
+        std::mutex editMutex;                   // Sérialise les modifications
+        std::shared_ptr<const Snapshot> current; // Protégé par QueryService::scenesMutex
+    };
+
+    std::string cacheDirectory;
+    int threads;
+
+    std::mutex scenesMutex;
+    std::map<std::string, std::shared_ptr<Scene>> scenes;
+
+    std::shared_ptr<Scene> findScene(const std::string& name);
+    std::shared_ptr<const Snapshot> snapshot(const std::string& name);
+    // Remplace l'instantané de scene, si elle est toujours celle enregistrée sous name
+    // (faux après un UNLOAD ou un LOAD du même nom pendant la modification : rien n'est publié)
+    bool publish(const std::string& name, const std::shared_ptr<Scene>& scene, std::shared_ptr<const Snapshot> snapshot);
+
+    std::string load(const std::string& name, const std::string& filename);
+    std::string edit(const std::string& name, const std::string& operation);
+    std::string point(const Snapshot& s, double x, double y) const;
+    std::string region(const Snapshot& s, int x0, int y0, int x1, int y1) const;
+    std::string tile(const Snapshot& s, int tx, int ty) const;
+};
+
+#endif // QUERY_SERVICE_HPP
@@ -0,0 +1,89 @@
+#ifndef RAY_FAN_HPP
+#define RAY_FAN_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "room.hpp"
+#include "occlusion_engine.hpp"
+
+/**
+ * Moteur en éventail de rayons : pour chaque émetteur, des rayons sont lancés jusqu'au bord
+ * de la grille (espacés d'au plus RAY_SPACING pixel au bout le plus lointain) et l'atténuation
+ * y est cumulée vers l'extérieur, une fois par obstacle et par rayon. Un pixel lit alors le
+ * cumul des deux rayons qui l'encadrent à sa distance de l'émetteur, au lieu de retracer tout
+ * son chemin.
+ *
+ * Aux bords d'ombre (les deux rayons ne traversent pas les mêmes obstacles, ou une entrée
+ * d'obstacle est à moins de EDGE_MARGIN du pixel), le pixel est calculé exactement par isBlocking, limité aux
+ * obstacles candidats de ses deux rayons. Les obstacles plus fins que l'espacement des rayons
+ * peuvent encore échapper au test : l'écart au calcul exact se mesure avec compareMaps.
+ * Les points derrière un MurDroit sont toujours vérifiés (voir AttenuationGrid).
+ *
+ * En mode exact (ENGINE rayfan exact, Room::engineExactness), chaque point est aussi calculé par
+ * isBlocking sur tous les obstacles : le moteur rend toujours sa propre valeur, et compte les
+ * points où elle s'écarte du calcul exact (mismatches, maxError).
+ */
+class RayFanEngine : public OcclusionEngine {
+public:
+    static constexpr double RAY_SPACING = 0.5;  // Écart maximal entre rayons voisins (pixels)
+    static constexpr double EDGE_MARGIN = 0.05; // Distance à une entrée d'obstacle jugée ambiguë
+
+    /**
+     * @param threads Threads utilisés pour lancer les rayons (0 = tous les cœurs)
+     * @param exactness Mode exact : chaque point comparé au calcul exact
+     */
+    RayFanEngine(const Room& room, int threads, bool exactness = false);
+
+    double occlusion(size_t emitter, int x, int y, std::vector<uint32_t>& scratch) const override;
+
+    // Nombre de rayons lancés pour un émetteur
+    int rayCount(size_t emitter) const { return fans[emitter].rays; }
+
+    // Mode exact : occlusions différentes du calcul exact (au-delà de MISMATCH_TOLERANCE) depuis la construction
+    long mismatches() const { return mismatchCount; }
+    // Mode exact : plus grand écart au calcul exact (dB)
+    double maxError() const { return maxMismatch; }
+
+    static constexpr double MISMATCH_TOLERANCE = 1e-9; // Arrondis des sommes dans un autre ordre
+
+private:
+    struct Fan {
+        double x, y;
+        int rays;
+        double step;                        // Angle entre deux rayons
+        std::vector<uint32_t> candidateStart; // Obstacles candidats du rayon i : [start[i], start[i+1])
+        std::vector<uint32_t> candidates;     // Obstacles dont la boîte englobante coupe le secteur du rayon
+        std::vector<uint32_t> entryStart;     // Entrées du rayon i : [entryStart[i], entryStart[i+1])
+        std::vector<double> entryRadius;      // Distance d'entrée dans chaque obstacle, croissante
+        std::vector<double> entryTotal;       // Atténuation cumulée au-delà (NAN : points à vérifier)
+        std::vector<uint64_t> entrySignature; // Signature cumulée des obstacles traversés
+    };
+
+    void buildFan(Fan& fan, int threads) const;
+
+    // Occlusion lue sur les rayons a et b qui encadrent le pixel (calcul exact aux bords d'ombre)
+    double fanOcclusion(const Fan& fan, int x, int y) const;
+
+    // Mode exact : compare value au calcul exact sur tous les obstacles et compte l'écart
+    void checkExact(const Fan& fan, int x, int y, double value) const;
+
+    // Position dans les entrées du rayon de la première entrée au-delà de la distance r
+    static size_t crossed(const Fan& fan, int ray, double r);
+
+    // Occlusion exacte, limitée aux candidats des rayons a et b
+    double exactOcclusion(const Fan& fan, int a, int b, int x, int y) const;
+
+    // Occlusion exacte sur tous les obstacles (pixels au pied de l'émetteur)
+    double exactOcclusion(const Fan& fan, int x, int y) const;
+
+    int width, height;
+    std::vector<const Obstacle*> obstacles;
+    std::vector<Fan> fans;
+
+    bool exactness;
+    mutable std::atomic<long> mismatchCount{0};
+    mutable std::atomic<double> maxMismatch{0.0};
+};
+
+#endif // RAY_FAN_HPP
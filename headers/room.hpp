@@ -4,8 +4,88 @@
 #include <vector>
 #include <fstream>
 #include <iostream>
+#include <cstdint>
+#include <memory>
+#include <string>
 #include "emitter.hpp"
+#include "propagation_model.hpp"
 #include "obstacle.hpp"
+#include "map_reader.hpp"
+
+/**
+ * Tuile rectangulaire de la grille : pixels [x0, x1) x [y0, y1)
+ * Unité de découpage du calcul parallèle
+ */
+struct Tile {
+    int x0, y0, x1, y1;
+};
+
+/**
+ * Moteur de calcul de l'occlusion utilisé par computeSignalMap
+ */
+enum class PropagationEngine {
+    Exact,  // isBlocking de chaque obstacle pour chaque point (référence)
+    Dda,    // Parcours DDA d'une grille d'obstacles rastérisée (voir attenuation_grid.hpp)
+    RayFan, // Éventail de rayons par émetteur, atténuation cumulée le long des rayons (voir ray_fan.hpp)
+    Polar   // Grille polaire par émetteur et sommes préfixes radiales, approché (voir polar_engine.hpp)
+};
+
+// Nom d'un moteur ("exact", "dda", "rayfan", "polar"), tel qu'écrit dans les fichiers de scène
+const char* engineName(PropagationEngine engine);
+
+// @return false si le nom est inconnu
+bool parseEngine(const std::string& name, PropagationEngine& engine);
+
+class OcclusionEngine;
+class ThroughputTable;
+
+/**
+ * Contribution d'un émetteur, décomposée en une partie géométrique et un décalage scalaire
+ * geometry = gain de distance (PropagationModel::distanceGain, -20·log10(d) en espace libre)
+ * moins l'atténuation des obstacles traversés
+ * La puissance reçue vaut power - frequencyLoss(frequency) + geometry, sauf aux points de
+ * nearField (d < 1 mm) où elle vaut power + geometry : changer la puissance ou la fréquence
+ * d'un émetteur ne fait que décaler sa couche d'une constante
+ */
+struct EmitterLayer {
+    std::vector<double> geometry;   // Ligne par ligne, width*height
+    std::vector<size_t> nearField;  // Indices des points en champ proche
+
+    // Nombre d'obstacles traversés par matériau et par point (si Room::keepCrossingCounts),
+    // CROSSING_SATURATED au-delà de 254 traversées
+    std::vector<std::vector<uint8_t>> crossings;
+    static constexpr uint8_t CROSSING_SATURATED = 255;
+};
+
+/**
+ * K meilleurs émetteurs de chaque point (Room::keepBestServers), rangés point par point :
+ * entrées k·pixel .. k·pixel + k - 1 par puissance décroissante (pixel = y·width + x)
+ */
+struct BestServers {
+    static constexpr uint16_t NONE = 0xFFFF; // Moins de k émetteurs au-dessus du plancher
+    static constexpr int MAX_K = 8;          // k est borné à MAX_K
+
+    int k = 0;                     // Émetteurs gardés par point (0 : rien de gardé)
+    std::vector<uint16_t> emitter; // Indice dans Room::emitters, ou NONE
+    std::vector<double> power;     // Puissance reçue (dB), Room::NOISE_FLOOR pour NONE
+};
+
+/**
+ * Cartes de desserte calculées en une passe par Room::computeServingMaps (même format que powerMap)
+ * Chaque point est servi par son meilleur émetteur et subit tous les autres comme interférence ;
+ * les puissances sont sommées en mW. Les émetteurs sous Room::NOISE_FLOOR en un point n'y comptent pas
+ */
+struct ServingMaps {
+    std::vector<std::vector<double>> bestPower;    // Puissance du meilleur émetteur (dB), comme powerMap en moteur exact
+    std::vector<std::vector<int>> bestServer;      // Indice du meilleur émetteur dans Room::emitters, -1 si aucun
+    std::vector<std::vector<double>> totalPower;   // Somme des puissances reçues (dB), NOISE_FLOOR si aucune
+    std::vector<std::vector<double>> interference; // Somme des autres émetteurs (dB), NOISE_FLOOR si aucun
+    std::vector<std::vector<double>> sinr;         // bestPower - (interférence + bruit), en dB
+
+    // Avec une table de débits seulement (vides sinon), lues dans la même passe que le SINR
+    std::vector<std::vector<int>> mcs;             // MCS du point, -1 si non servi
+    std::vector<std::vector<double>> throughput;   // Débit attendu (Mb/s)
+};
 
 /**
  * Classe représentant une salle de simulation de propagation de signaux
@@ -18,13 +98,67 @@ public:
     std::vector<Emitter> emitters;  // Liste des émetteurs
     std::vector<Obstacle*> obstacles; // Liste des obstacles
     std::vector<std::vector<double>> powerMap; // Carte des puissances reçues
+    std::vector<int16_t> quantizedMap;         // Même carte en stockage quantifié, ligne par ligne
+
+    static constexpr int TILE_SIZE = 64; // Côté des tuiles de calcul (en pixels)
+    static constexpr double NOISE_FLOOR = -100.0; // Plancher des cartes (dB) : puissance des points non couverts
+    static constexpr double THERMAL_NOISE = -95.0; // Bruit de fond par défaut du SINR (dBm, canal de 20 MHz)
+    static constexpr int BOUNDARY_MARGIN = 3; // Bords de la salle marqués comme obstacles (markRoomBoundaries)
+    int threads = 0;                     // Threads utilisés par computeSignalMap (0 = tous les cœurs)
+    PropagationEngine engine = PropagationEngine::Exact; // Moteur de computeSignalMap (les couches restent exactes)
+    // Mode exact du moteur rayfan (ENGINE rayfan exact) : chaque point est aussi calculé par
+    // isBlocking, la carte restant celle du moteur ; écarts comptés dans engineMismatches
+    bool engineExactness = false;
+    long engineMismatches = 0; // Occlusions du dernier computeSignalMap différentes du calcul exact
+    PropagationModel model;              // Affaiblissement sans obstacles et résolution de la grille
+    Precision precision = Precision::Double; // Précision du moteur exact par tuiles (Float : opt-in, approché)
+
+    // Conserver la contribution de chaque émetteur : couches remplies par la passe exacte par
+    // tuiles, qui calcule aussi la carte (le moteur choisi n'est alors pas utilisé)
+    bool keepEmitterLayers = false;
+    // Couche géométrique de chaque émetteur, partagée par les copies de la salle (instantanés) :
+    // une couche n'est copiée que lorsqu'elle est modifiée (voir writableLayer)
+    std::vector<std::shared_ptr<const EmitterLayer>> emitterLayers;
+
+    int keepBestServers = 0;  // Garder les K meilleurs émetteurs de chaque point (moteur exact)
+    // Rempli par computeSignalMap si keepBestServers > 0, vide sinon ; vidé par toute modification
+    // des émetteurs, des obstacles ou des atténuations (hors deleteEmitter, qui le met à jour)
+    BestServers bestServers;
+
+    bool keepCrossingCounts = false; // Conserver les traversées par matériau dans chaque couche
+    std::vector<double> materials;   // Atténuation de chaque matériau (obstacles de même atténuation)
 
     /**
      * Constructeur initialisant la grille avec une puissance par défaut
      * @param width Largeur de la grille
      * @param height Hauteur de la grille
+     * @param allocateMap false pour ne pas allouer powerMap (carte gardée hors mémoire, voir tiled_map.hpp)
+     */
+    Room(int width, int height, bool allocateMap = true);
+
+    /**
+     * Choisit le stockage de la carte : doubles (powerMap) ou centièmes de dBm sur 16 bits
+     * (quantizedMap, voir QuantizedPower), 4 fois moins de mémoire et de bande passante
+     * Le contenu courant est converti et l'autre stockage libéré
+     */
+    void setQuantizedStorage(bool enabled);
+    bool isQuantized() const { return quantized; }
+
+    // Indique si une carte est allouée (dans l'un ou l'autre stockage)
+    bool hasPowerMap() const { return quantized ? !quantizedMap.empty() : !powerMap.empty(); }
+
+    /**
+     * Puissance en un point de la carte, quel que soit le stockage (-555 sur les obstacles)
      */
-    Room(int width, int height);
+    double getPower(int x, int y) const {
+        return quantized ? QuantizedPower::decode(quantizedMap[static_cast<size_t>(y) * width + x]) : powerMap[y][x];
+    }
+
+    /**
+     * Lecture ligne par ligne de la carte, quel que soit le stockage
+     * La salle doit survivre au lecteur
+     */
+    std::unique_ptr<PowerMapReader> mapReader() const;
 
     /**
      * Ajoute un émetteur à la simulation
@@ -32,6 +166,7 @@ public:
      */
     void addEmitter(Emitter e) {
         emitters.push_back(e);
+        bestServers = BestServers(); // Le nouvel émetteur n'y figure pas
     }
 
     /**
@@ -40,15 +175,144 @@ public:
      */
     void addObstacle(Obstacle* o) {
         obstacles.push_back(o);
+        bestServers = BestServers(); // Calculé sans cet obstacle
     }
 
     /**
      * Calcule la carte de puissance pour chaque point de la grille
      * Combine les contributions de tous les émetteurs en tenant compte des obstacles
      */
-    // Optimisation: calcul parallèle des signaux ou pré-calcul des obstacles
+    // Calcul parallèle par tuiles de TILE_SIZE x TILE_SIZE pixels
     void computeSignalMap(void);
 
+    /**
+     * Découpe la grille en tuiles de TILE_SIZE x TILE_SIZE (tronquées sur les bords)
+     */
+    std::vector<Tile> tiles() const;
+
+    /**
+     * Puissance reçue en un point (maximum des émetteurs, plancher à -100 dB), sans passer par powerMap
+     * Même calcul que computeSignalMap, pour les traitements qui ne conservent pas la carte
+     */
+    double computePointPower(int x, int y) const;
+
+    /**
+     * Même calcul avec l'occlusion fournie par un moteur préparé (calcul exact si occlusion est nullptr),
+     * sur les seuls émetteurs préparés par le moteur
+     * @param scratch Tampon de travail de OcclusionEngine::occlusion
+     */
+    double computePointPower(int x, int y, const OcclusionEngine* occlusion, std::vector<uint32_t>& scratch) const;
+
+    /**
+     * Puissance de chaque point d'une tuile, même calcul que computePointPower
+     * Moteur exact : les obstacles sont classés une fois par émetteur pour toute la tuile (jamais,
+     * toujours ou peut-être bloquants), seuls les derniers sont testés point par point.
+     * En Precision::Float, noyau de puissance et tests par paquets sont faits en float
+     * Émetteurs hors de portée de la tuile écartés (PropagationModel::range), puis, par paquet,
+     * émetteurs pris par puissance sans obstacles décroissante : un émetteur (ou le reste de ses
+     * obstacles) n'est plus évalué dès qu'il ne peut plus dépasser le maximum courant (le k-ième
+     * meilleur si servers est demandé)
+     * @param bounded obstaclesOnlyAttenuate(), évalué une fois par calcul : sinon ni portée ni séparation
+     * @param out Ligne y de la tuile à out + (y - tile.y0) * stride
+     * @param servers Si non nul (moteur exact), reçoit les servers->k meilleurs émetteurs des points
+     */
+    void computeTilePower(const Tile& tile, const OcclusionEngine* occlusion, bool bounded, double* out, size_t stride,
+                          BestServers* servers = nullptr) const;
+
+    /**
+     * Vrai si aucun obstacle n'a d'atténuation négative : la puissance sans obstacles majore alors
+     * la contribution de chaque émetteur, et les émetteurs hors de portée restent sous le plancher
+     */
+    bool obstaclesOnlyAttenuate() const;
+
+    /**
+     * Prépare le moteur choisi (nullptr pour le moteur exact), une fois par calcul
+     * Le moteur garde des pointeurs vers les obstacles : la salle ne doit pas changer entre-temps
+     */
+    std::unique_ptr<OcclusionEngine> prepareEngine() const;
+
+    /**
+     * Même moteur, préparé pour les émetteurs à partir de first seulement : le moteur polaire
+     * s'arrête au groupe dont les grilles tiennent dans son budget mémoire, les autres moteurs
+     * prennent tous les émetteurs. Le groupe suivant commence à endEmitter du moteur rendu
+     */
+    std::unique_ptr<OcclusionEngine> prepareEngineGroup(size_t first) const;
+
+    /**
+     * Calcule en une passe une carte par fréquence, chaque émetteur étant évalué à cette fréquence
+     * L'occlusion et le gain de distance ne dépendent pas de la fréquence : ils sont calculés une
+     * seule fois par point et par position d'émission, seul un décalage constant change entre cartes
+     * @param frequencies Fréquences à évaluer (Hz)
+     * @return Une carte (même format que powerMap) par fréquence
+     */
+    std::vector<std::vector<std::vector<double>>> computeMultiFrequencyMaps(const std::vector<double>& frequencies);
+
+    /**
+     * Calcule une carte par bande (fréquence distincte des émetteurs), chaque émetteur contribuant
+     * à sa propre bande. Les émetteurs bi/tri-bandes, déclarés comme un émetteur par bande à la même
+     * position, partagent le calcul d'occlusion
+     * @param[out] bands Fréquence de chaque carte, dans l'ordre croissant
+     */
+    std::vector<std::vector<std::vector<double>>> computeBandMaps(std::vector<double>& bands);
+
+    /**
+     * Calcule en une passe les cartes de desserte : meilleur émetteur, son indice, puissance totale,
+     * interférence et SINR. Même calcul que le moteur exact par tuiles (en double), chaque émetteur
+     * à portée étant évalué entièrement puis cumulé en mW : conversion en mW par paquet (vectorisée
+     * avec -fno-trapping-math), retour en dB scalaire, trois std::log10 par point
+     * @param noise Bruit de fond (dBm) ajouté à l'interférence pour le SINR
+     * @param table Si non nulle, MCS et débit de chaque point sont aussi tirés du SINR, par paquet
+     */
+    ServingMaps computeServingMaps(double noise = THERMAL_NOISE, const ThroughputTable* table = nullptr) const;
+
+    /**
+     * Recalcule la couche d'un seul émetteur (nécessite keepEmitterLayers)
+     * Utilisé après l'ajout ou le déplacement d'un émetteur ; tuile par tuile en parallèle,
+     * par le noyau par paquets du moteur exact (computeLayerTile)
+     */
+    void computeEmitterLayer(size_t index);
+
+    /**
+     * Ajoute (sign = 1) ou retire (sign = -1) l'atténuation d'un obstacle dans toutes les couches
+     * Seuls les points masqués par cet obstacle sont modifiés, sans recalcul des autres
+     */
+    void applyObstacleToLayers(const Obstacle* obstacle, double sign);
+
+    /**
+     * Recombine les couches par émetteur en carte de puissance (maximum, plancher à -100 dB)
+     * Le décalage de chaque émetteur est recalculé à partir de sa puissance et de sa fréquence
+     */
+    void combineEmitterLayers(void);
+
+    // Décalage de la couche d'un émetteur hors champ proche : power - frequencyLoss(frequency)
+    double layerOffset(size_t emitter) const;
+
+    /**
+     * Puissance reçue d'un émetteur en un point, lue dans sa couche : offset + geometry, ou
+     * power + geometry aux points de nearField (voir EmitterLayer)
+     * @param offset layerOffset(emitter), calculé une fois par l'appelant
+     */
+    double layerPower(size_t emitter, size_t pixel, double offset) const;
+
+    /**
+     * Change l'atténuation de tous les obstacles d'un matériau (calibration, ex. plâtre de 5 à 3 dB)
+     * Avec les traversées conservées, les couches sont corrigées par re-sommation
+     * (geometry -= delta * traversées), sans aucun test d'occlusion
+     * @return false si aucun obstacle n'a cette atténuation
+     */
+    bool setMaterialAttenuation(double oldAttenuation, double newAttenuation);
+
+    /**
+     * Modifie la puissance d'émission d'un émetteur
+     * Avec des couches conservées, seule la recombinaison est refaite (quelques millisecondes)
+     */
+    void setEmitterPower(size_t index, double power);
+
+    /**
+     * Modifie la fréquence d'un émetteur (même mécanisme que setEmitterPower)
+     */
+    void setEmitterFrequency(size_t index, double frequency);
+
     /**
      * Marque les zones occupées par les obstacles sur la carte de puissance
      * Utilise la valeur spéciale -555 pour identifier les obstacles
@@ -56,14 +320,175 @@ public:
     // Marquer les obstacles sur la heatmap
     void markObstaclesOnPowerMap(void);
 
+    /**
+     * Obstacles dont la zone d'influence (getExpandedBounds) touche la tuile
+     */
+    std::vector<const Obstacle*> obstaclesTouching(const Tile& tile) const;
+
+    /**
+     * Indique si markObstaclesOnPowerMap marquerait le point (bords de la salle ou intérieur
+     * d'un obstacle), sans passer par powerMap
+     * @param candidates Obstacles à tester (obstaclesTouching de la tuile du point)
+     */
+    bool isMarkedAsObstacle(int x, int y, const std::vector<const Obstacle*>& candidates) const;
+
+    /**
+     * Points d'évaluation des optimisations (placement, plan de canaux) : grille grossière de pas
+     * step à partir de (BOUNDARY_MARGIN, BOUNDARY_MARGIN), hors points marqués comme obstacles
+     * @return Indices y * width + x, ligne par ligne
+     */
+    std::vector<size_t> samplePoints(int step) const;
+
 
     void exportToCSV(const std::string& filename);
 
+    /**
+     * Exporte la carte (et la partie géométrique des couches par émetteur si présentes) au format binaire
+     * En-tête : "PMAP", version, largeur, hauteur, nombre de couches, hash de la scène
+     * puis chaque couche en doubles, ligne par ligne
+     * @return true si l'écriture a réussi
+     */
+    bool exportToBinary(const std::string& filename) const;
+
+    /**
+     * Recharge une carte exportée par exportToBinary
+     * @param expectedHash Hash de scène attendu (0 pour ne pas vérifier)
+     * @return false si le fichier est absent, corrompu ou ne correspond pas à la salle
+     */
+    bool loadFromBinary(const std::string& filename, uint64_t expectedHash = 0);
+
+    /**
+     * Écrit une description canonique de la scène : dimensions, RESOLUTION_FACTOR,
+     * version du modèle, moteur qui calcule la carte s'il n'est pas exact (le moteur exact quand
+     * keepEmitterLayers est demandé), émetteurs et obstacles (dans l'ordre d'ajout)
+     */
+    void describe(std::ostream& os) const;
+
+    /**
+     * Hash FNV-1a 64 bits de la description canonique de la scène
+     */
+    uint64_t sceneHash() const;
+
+    /**
+     * Supprime un émetteur. Si bestServers garde au moins 2 émetteurs par point, la carte est mise
+     * à jour sans recalcul (le suivant remplace l'émetteur supprimé) et bestServers en garde un de
+     * moins ; sinon bestServers est vidé et la carte reste à recalculer
+     * Sa couche est retirée de emitterLayers (recombinées ensuite par combineEmitterLayers)
+     * @return false si aucun émetteur n'est à cette position
+     */
     bool deleteEmitter(double x, double y);
 
+    /**
+     * Couverture en cas de panne de chaque émetteur, en une passe sur bestServers (k >= 2)
+     * Points marqués par markObstaclesOnPowerMap (isMarkedAsObstacle) exclus, comme dans les
+     * statistiques de couverture : le pourcentage se compare à celui de coverageStatisticsFromMap
+     * @return Pourcentage des points au-dessus de threshold sans l'émetteur e, pour chaque e
+     *         (vide si bestServers garde moins de 2 émetteurs)
+     */
+    std::vector<double> singleFailureCoverage(double threshold) const;
+
+    /**
+     * Supprime le mur de ces extrémités (à 0.001 près), sans le libérer
+     * Son atténuation est retirée des couches par émetteur (applyObstacleToLayers) ; la carte
+     * reste à recalculer ou à recombiner
+     * @return false si aucun mur n'a ces extrémités
+     */
     bool deleteObstacle(double x1, double y1, double x2, double y2);
 
 private:
+    bool quantized = false; // Carte stockée dans quantizedMap plutôt que powerMap
+
+    void setPower(int x, int y, double value) {
+        if (quantized) quantizedMap[static_cast<size_t>(y) * width + x] = QuantizedPower::encode(value);
+        else powerMap[y][x] = value;
+    }
+
+    // Indices des points en champ proche d'un émetteur (d < 1 mm)
+    std::vector<size_t> nearFieldPixels(const Emitter& emitter) const;
+
+    // Couche d'un émetteur à modifier : copiée d'abord si une autre copie de la salle la partage
+    EmitterLayer& writableLayer(size_t index);
+
+    // Matériau de chaque obstacle (indice dans materials), aligné sur obstacles
+    std::vector<size_t> obstacleMaterials;
+
+    // Associe chaque obstacle à son matériau ; les nouveaux matériaux sont ajoutés à la fin de
+    // materials (ordre existant conservé) avec des comptes nuls dans les couches qui en ont
+    void indexMaterials(void);
+
+    // Obstacle à considérer pour un émetteur sur toute une tuile
+    struct TileObstacle {
+        PreparedObstacle prepared; // Obstacle préparé pour l'émetteur (Obstacle::prepare)
+        bool always; // Bloque tous les points de la tuile (sinon isBlocking point par point)
+        size_t index; // Rang dans obstacles (matériau des traversées comptées)
+    };
+
+    /**
+     * Classe les obstacles pour un émetteur et une tuile, de façon conservatrice :
+     * - jamais bloquant : un axe sépare la boîte englobante de l'enveloppe émetteur + tuile (écarté)
+     * - toujours bloquant : émetteur dans l'obstacle, ou les quatre coins de la tuile bloqués
+     *   (l'ombre d'un obstacle convexe est convexe ; pas pour MurDroit, qui ignore ses extrémités)
+     * - sinon à tester point par point
+     * L'ordre des obstacles est conservé : les sommes restent identiques au calcul exact
+     */
+    void classifyObstacles(const Emitter& emitter, const Tile& tile, std::vector<TileObstacle>& out) const;
+
+    // Cartes de desserte d'une tuile (voir computeServingMaps), maps déjà dimensionnées
+    void computeServingTile(const Tile& tile, double noise, const ThroughputTable* table, bool bounded, ServingMaps& maps) const;
+
+    // Émetteurs dont la portée (PropagationModel::range jusqu'à NOISE_FLOOR) atteint la tuile,
+    // tous si bounded est faux (une atténuation négative peut remonter un émetteur hors de portée)
+    std::vector<size_t> emittersInRange(const Tile& tile, bool bounded) const;
+
+    // Distance (unités de grille) d'une position au pixel le plus proche de la tuile
+    static double tileDistance(const Tile& tile, double x, double y);
+
+    // Retire un émetteur supprimé de bestServers (indices suivants décalés) et met la carte à jour
+    void removeFromBestServers(uint16_t removed);
+
+    /**
+     * Moteur exact de computeTilePower, calculs dans le type Scalar (double ou float)
+     * @param layers Si non nul, tous les émetteurs sont évalués entièrement (ni portée ni
+     *        séparation) et leur couche (une par émetteur) remplie dans la même passe : gain de
+     *        distance moins obstacles, traversées par matériau si keepCrossingCounts
+     */
+    template <typename Scalar>
+    void computeExactTilePower(const Tile& tile, bool bounded, double* out, size_t stride, BestServers* servers,
+                               const std::vector<EmitterLayer*>* layers) const;
+
+    // Partie géométrique de la couche d'un émetteur en un point ; compte les traversées
+    // par matériau dans layer si keepCrossingCounts
+    double layerGeometry(const Emitter& emitter, int x, int y, EmitterLayer* layer) const;
+
+    // Couche d'un émetteur sur une tuile (computeEmitterLayer) : obstacles classés pour la tuile,
+    // tests par paquets ; mêmes valeurs et traversées que layerGeometry en chaque point
+    void computeLayerTile(const Tile& tile, const Emitter& emitter, EmitterLayer& layer) const;
+
+    // Contribution d'un émetteur à l'une des cartes d'un calcul multi-fréquence
+    struct FrequencyContribution {
+        size_t map;         // Indice de la carte de sortie
+        double power;       // Puissance émise (champ proche)
+        double frequency;   // Fréquence évaluée (Hz), pour la portée
+        double offset;      // power - Emitter::frequencyLoss(fréquence évaluée)
+    };
+
+    /**
+     * Calcule plusieurs cartes en partageant l'occlusion entre contributions de même position
+     * Noyau par tuiles du moteur exact (en double) : positions à portée de la tuile, obstacles
+     * classés une fois par position, tests par paquets ; seul le décalage change entre cartes
+     */
+    std::vector<std::vector<std::vector<double>>> computeSharedGeometryMaps(
+        size_t mapCount, const std::vector<std::pair<size_t, FrequencyContribution>>& contributions);
+
+    /**
+     * Calcule la carte de puissance sur une tuile (indépendante des autres tuiles)
+     * @param occlusion Moteur préparé (nullptr pour le calcul exact)
+     * @param layers Couches à remplir dans la même passe exacte (voir computeExactTilePower), ou nullptr
+     * @param accumulate Garde le maximum avec la carte existante (groupes d'émetteurs suivants)
+     */
+    void computeTile(const Tile& tile, const OcclusionEngine* occlusion, bool bounded,
+                     const std::vector<EmitterLayer*>* layers = nullptr, bool accumulate = false);
+
     /**
      * Marque les bords de la salle comme zones obstacles
      * Ajoute une bordure de sécurité de 2 unités
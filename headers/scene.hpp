@@ -0,0 +1,53 @@
+#ifndef SCENE_HPP
+#define SCENE_HPP
+
+#include <string>
+#include "room.hpp"
+
+/**
+ * Fichiers de scène texte, une déclaration par ligne (même syntaxe que Room::describe) :
+ *   ROOM largeur hauteur                      (obligatoire, en premier)
+ *   EMITTER x y puissance frequence
+ *   MUR x1 y1 x2 y2 epaisseur attenuation
+ *   MURDROIT x1 y1 x2 y2 epaisseur attenuation
+ *   CERCLE cx cy rayon attenuation
+ *   FLOORPLAN fichier.svg|fichier.dxf [echelle [attenuation [epaisseur]]] [FLIPY|NOFLIPY]
+ *                                             (FLIPY : axe Y du plan vers le haut, origine en bas à
+ *                                             gauche de la salle ; par défaut pour un .dxf, NOFLIPY
+ *                                             pour un .dxf déjà orienté comme la salle)
+ *   ENGINE exact|dda|rayfan|polar             (moteur de calcul, exact par défaut)
+ *   ENGINE rayfan exact                       (rayfan vérifié point par point, voir RayFanEngine)
+ *   PATHLOSS freespace | logdistance n | dualslope n cassure n2
+ *                                             (affaiblissement, espace libre par défaut, cassure en m)
+ *   PRECISION double|float                    (précision du moteur exact, double par défaut)
+ *   RESOLUTION r                              (unités de grille par mètre, RESOLUTION_FACTOR par défaut)
+ *   MODEL v                                   (informatif)
+ * Les lignes vides et celles commençant par # sont ignorées
+ * Un FLOORPLAN dont aucun segment n'est lu (fichier absent, illisible) fait échouer le chargement
+ */
+
+/**
+ * Charge une scène depuis un fichier texte
+ * @param allocateMap false pour ne pas allouer powerMap (voir Room::Room)
+ * @return Salle allouée (à libérer avec deleteScene) ou nullptr en cas d'erreur
+ */
+Room* loadScene(const std::string& filename, bool allocateMap = true);
+
+/**
+ * Construit un obstacle à partir d'une déclaration MUR, MURDROIT ou CERCLE
+ * Un MURDROIT oblique est signalé ici, une fois, puis calculé comme un MUR
+ * @return Obstacle alloué, ou nullptr si la ligne n'est pas un obstacle valide
+ */
+Obstacle* parseObstacle(const std::string& line);
+
+/**
+ * Enregistre la scène (dimensions, émetteurs, obstacles) au format texte
+ */
+bool saveScene(const Room& room, const std::string& filename);
+
+/**
+ * Libère une salle chargée par loadScene ainsi que ses obstacles
+ */
+void deleteScene(Room* room);
+
+#endif // SCENE_HPP
@@ -0,0 +1,49 @@
+#ifndef THROUGHPUT_HPP
+#define THROUGHPUT_HPP
+
+#include <string>
+#include <vector>
+
+/**
+ * Table de correspondance SINR -> MCS -> débit
+ * Un point utilise l'entrée de plus grand SINR minimal qu'il atteint ; sous la première, il
+ * n'est pas servi (MCS -1, débit nul). Par défaut : 802.11n, 20 MHz, 1 flux spatial, GI 800 ns
+ */
+class ThroughputTable {
+public:
+    struct Entry {
+        int mcs;
+        double minSinr; // SINR minimal (dB)
+        double rate;    // Débit (Mb/s)
+    };
+
+    ThroughputTable();
+
+    /**
+     * Remplace la table par celle d'un fichier texte : une entrée "mcs sinr_min debit" par ligne,
+     * lignes vides et commentaires (#) ignorés
+     * @return false si le fichier est illisible, mal formé ou vide (table inchangée)
+     */
+    bool load(const std::string& filename);
+
+    /**
+     * MCS et débit de count points : sans branchement par point (un passage par entrée de la
+     * table, vectorisable), appelé par paquet dans la passe des cartes de desserte
+     */
+    void lookup(const double* sinr, int count, int* mcs, double* rate) const;
+
+    // Débit de la meilleure entrée (échelle d'affichage)
+    double maxRate() const;
+
+    const std::vector<Entry>& getEntries() const { return entries; }
+
+private:
+    void setEntries(std::vector<Entry> sorted);
+
+    std::vector<Entry> entries;     // Par SINR minimal croissant
+    std::vector<double> thresholds; // SINR minimal de chaque entrée
+    std::vector<int> mcsByLevel;    // Niveau k = nombre de seuils atteints, MCS -1 au niveau 0
+    std::vector<double> rateByLevel;
+};
+
+#endif // THROUGHPUT_HPP
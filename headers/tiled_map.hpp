@@ -0,0 +1,132 @@
+#ifndef TILED_MAP_HPP
+#define TILED_MAP_HPP
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "room.hpp"
+#include "map_reader.hpp"
+#include "occlusion_engine.hpp"
+
+/**
+ * Carte de puissance stockée par tuiles dans un fichier projeté en mémoire (mmap)
+ *
+ * Pour les très grandes surfaces, où powerMap ne tient pas en mémoire (500 m x 500 m à
+ * 1 cm = 2,5 milliards de points). Chaque tuile de Room::TILE_SIZE x TILE_SIZE est calculée
+ * à la première lecture, obstacles marqués (-555) comme par markObstaclesOnPowerMap, puis
+ * reste projetée tant qu'elle fait partie des maxResidentTiles dernières utilisées (LRU) ;
+ * une tuile évincée est réécrite sur disque par le système. La taille de la carte n'est
+ * donc limitée que par le disque. Le moteur d'occlusion est préparé à la première tuile à
+ * calculer ; un moteur polaire trop grand pour un seul groupe d'émetteurs (PolarEngine::GROUP_BUDGET)
+ * est préparé groupe par groupe sur toutes les tuiles manquantes à la fois.
+ *
+ * Format du fichier : une page d'en-tête ("PTIL", version, dimensions, taille des tuiles,
+ * hash de la scène), un octet d'état par tuile (calculée ou non), puis les tuiles complètes
+ * (TILE_SIZE² doubles, ligne par ligne), chacune au début d'une page (tuiles espacées de TILE_BYTES
+ * arrondi à la taille de page, 64 Kio sur certains systèmes). Un fichier existant de la même
+ * scène est réutilisé : les tuiles déjà calculées ne sont pas recalculées.
+ *
+ * La salle doit rester inchangée pendant toute la durée de vie de la carte.
+ * Non disponible sous Windows (isOpen() renvoie false).
+ */
+class TiledMap : public PowerMapReader {
+public:
+    /**
+     * @param room Scène à calculer (powerMap n'est pas utilisée, voir Room(w, h, false))
+     * @param filename Fichier de stockage, créé ou réutilisé
+     * @param maxResidentTiles Tuiles gardées projetées en même temps (au moins une ligne de tuiles)
+     */
+    TiledMap(const Room& room, const std::string& filename, size_t maxResidentTiles = 256);
+    ~TiledMap();
+
+    TiledMap(const TiledMap&) = delete;
+    TiledMap& operator=(const TiledMap&) = delete;
+
+    bool isOpen() const { return fd >= 0; }
+
+    /**
+     * Vrai dès qu'une tuile n'a pas pu être projetée (espace d'adressage épuisé) : les points
+     * qu'elle portait ont été lus comme NaN par readRow et at, la carte lue est incomplète
+     */
+    bool hasFailed() const { return failed; }
+
+    int mapWidth() const override { return room.width; }
+    int mapHeight() const override { return room.height; }
+    void readRow(int y, int x0, int x1, double* out) override;
+
+    // Puissance en un point (calcule sa tuile si nécessaire ; NaN si elle n'a pas pu être projetée)
+    double at(int x, int y);
+
+    /**
+     * Calcule toutes les tuiles manquantes, par groupes de maxResidentTiles en parallèle
+     * (Room::threads threads)
+     * @return false si la carte n'est pas ouverte ou si une tuile n'a pas pu être projetée
+     */
+    bool computeAll();
+
+    // Nombre de tuiles déjà calculées (dans ce fichier, y compris lors d'exécutions précédentes)
+    size_t computedTiles() const;
+    size_t tileCount() const { return static_cast<size_t>(tilesX) * tilesY; }
+
+    // Force l'écriture sur disque des tuiles projetées
+    void flush();
+
+private:
+    struct Resident {
+        double* data;
+        std::list<size_t>::iterator position; // Dans lru
+    };
+
+    const Room& room;
+    // Moteur préparé à la première tuile manquante (nullptr pour le calcul exact) ; moteur polaire
+    // en plusieurs groupes d'émetteurs : un groupe à la fois, pendant computeMissing
+    std::unique_ptr<OcclusionEngine> occlusion;
+    bool enginePrepared = false;
+    bool bounded = true;        // Room::obstaclesOnlyAttenuate, évalué une fois
+    int fd = -1;
+    bool failed = false;        // Une tuile n'a pas pu être projetée (hasFailed)
+    int tilesX = 0, tilesY = 0;
+    size_t maxResident;
+    size_t headerBytes = 0;     // En-tête et états, multiple de la taille de page
+    size_t tileStride = 0;      // Écart entre deux tuiles du fichier : TILE_BYTES arrondi à la taille de page
+    uint8_t* header = nullptr;  // Projection de l'en-tête et des états
+    uint8_t* states = nullptr;  // Un octet par tuile (1 = calculée)
+
+    std::mutex mutex;           // Protège la table des tuiles projetées
+    std::list<size_t> lru;      // Tuiles projetées, la plus récente en tête
+    std::unordered_map<size_t, Resident> resident;
+
+    static constexpr size_t TILE_BYTES = sizeof(double) * Room::TILE_SIZE * Room::TILE_SIZE;
+
+    Tile tileBounds(size_t index) const;
+
+    // Projette une tuile (en évinçant la moins récente si besoin), sans la calculer
+    // nullptr (et failed) si mmap échoue
+    double* mapTile(size_t index);
+
+    // Projette une tuile et la calcule si elle ne l'a jamais été (appelant verrouillé) ; avec un
+    // moteur en plusieurs groupes, calcule toutes les tuiles manquantes. nullptr en cas d'échec
+    double* acquireTile(size_t index);
+
+    // computeAll, appelant verrouillé : toutes les tuiles pour un groupe d'émetteurs, puis le suivant
+    bool computeMissing();
+
+    // Prépare occlusion pour le premier groupe d'émetteurs, s'il ne l'est pas déjà
+    void prepareOcclusion();
+
+    // Vrai si des émetteurs suivent le groupe préparé
+    bool grouped() const;
+
+    /**
+     * Remplit une tuile : puissance, ou -555 aux points marqués comme obstacles
+     * @param accumulate Garde le maximum avec la tuile déjà écrite (groupes d'émetteurs suivants)
+     */
+    void computeTile(size_t index, double* data, int threads, bool accumulate = false) const;
+
+    void unmapTile(size_t index);
+};
+
+#endif // TILED_MAP_HPP
@@ -13,11 +13,47 @@
 #include "headers/obstacle.hpp"
 #include "headers/room.hpp"
 #include "headers/display.hpp"
+#include "headers/scene.hpp"
+#include "headers/tiled_map.hpp"
 
 #include <SDL.h>
 
 
-int main() {
+// Usage : main                                 scène de démonstration ci-dessous
+//         main scene.txt                       scène chargée (format de scene.hpp), interactive
+//         main scene.txt --tiled carte.tiles   carte par tuiles sur disque (TiledMap), en lecture
+//                                              seule : pour les surfaces dont powerMap ne tient pas en mémoire
+int displayScene(int argc, char** argv) {
+    const std::string scene = argv[1];
+    const bool tiled = argc >= 4 && std::string(argv[2]) == "--tiled";
+    if (argc != 2 && !(tiled && argc == 4)) {
+        std::cerr << "Usage: main [scene.txt [--tiled carte.tiles]]" << std::endl;
+        return 1;
+    }
+
+    Room* room = loadScene(scene, !tiled);
+    if (!room) return 1;
+    int result = 1;
+    if (tiled) {
+        // Tuiles calculées à la première lecture par l'affichage, ou reprises d'un fichier existant
+        TiledMap map(*room, argv[3]);
+        if (map.isOpen()) {
+            std::cout << map.computedTiles() << "/" << map.tileCount() << " tuiles deja calculees" << std::endl;
+            result = displayingMap(map);
+            if (map.hasFailed()) result = 1; // Tuiles affichées incomplètes
+        }
+    } else {
+        room->computeSignalMap();
+        room->markObstaclesOnPowerMap();
+        result = displaying(room);
+    }
+    deleteScene(room);
+    return result;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1) return displayScene(argc, argv);
+
     Room room(1220, 600); // Résolution Full HD
 
     // Ajout d'un émetteur Wi-Fi
@@ -0,0 +1,135 @@
+// Service local de requêtes sur des scènes gardées en mémoire
+//
+// Usage : server [-s chemin_socket] [-j N] [--cache repertoire]
+//
+// Écoute sur une socket Unix (par défaut /tmp/propagation.sock). Chaque client envoie
+// des requêtes texte, une par ligne (voir query_service.hpp), et reçoit une réponse par
+// ligne. Les clients sont servis en parallèle ; la requête SHUTDOWN arrête le service.
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "headers/query_service.hpp"
+
+#ifdef _WIN32
+
+int main() {
+    std::cerr << "Le service de requetes utilise les sockets Unix et n'est pas disponible sous Windows" << std::endl;
+    return 1;
+}
+
+#else
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+std::atomic<bool> running(true);
+
+bool sendLine(int fd, std::string line) {
+    line += "\n";
+    size_t sent = 0;
+    while (sent < line.size()) {
+        const ssize_t n = ::send(fd, line.data() + sent, line.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+void serveClient(int fd, QueryService& service, int listenFd) {
+    std::string buffer;
+    char chunk[4096];
+    bool open = true;
+    while (open) {
+        const ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) break;
+        buffer.append(chunk, static_cast<size_t>(n));
+
+        size_t end;
+        while ((end = buffer.find('\n')) != std::string::npos) {
+            std::string request = buffer.substr(0, end);
+            buffer.erase(0, end + 1);
+            if (!request.empty() && request.back() == '\r') request.pop_back();
+            if (request.empty()) continue;
+
+            if (request == "QUIT") {
+                open = false;
+                break;
+            }
+            if (request == "SHUTDOWN") {
+                sendLine(fd, "OK");
+                running = false;
+                ::shutdown(listenFd, SHUT_RDWR); // Débloque accept()
+                open = false;
+                break;
+            }
+            if (!sendLine(fd, service.handle(request))) {
+                open = false;
+                break;
+            }
+        }
+    }
+    ::close(fd);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string socketPath = "/tmp/propagation.sock";
+    std::string cacheDirectory;
+    int threads = 0;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "-s" && i + 1 < argc) socketPath = argv[++i];
+        else if (arg == "-j" && i + 1 < argc) threads = std::atoi(argv[++i]);
+        else if (arg == "--cache" && i + 1 < argc) cacheDirectory = argv[++i];
+        else {
+            std::cerr << "Usage: server [-s chemin_socket] [-j N] [--cache repertoire]" << std::endl;
+            return 1;
+        }
+    }
+
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Chemin de socket trop long: " << socketPath << std::endl;
+        return 1;
+    }
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    const int listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ::unlink(socketPath.c_str());
+    if (listenFd < 0 || ::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listenFd, 16) != 0) {
+        std::cerr << "Impossible d'ecouter sur " << socketPath << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    std::cout << "Service de requetes en ecoute sur " << socketPath << std::endl;
+
+    // Jamais détruit : des clients détachés peuvent encore l'utiliser à l'arrêt
+    QueryService& service = *new QueryService(cacheDirectory, threads);
+    while (running) {
+        const int clientFd = ::accept(listenFd, nullptr, nullptr);
+        if (clientFd < 0) {
+            if (!running) break;
+            continue;
+        }
+        std::thread(serveClient, clientFd, std::ref(service), listenFd).detach();
+    }
+
+    ::close(listenFd);
+    ::unlink(socketPath.c_str());
+    std::cout << "Service arrete" << std::endl;
+    return 0;
+}
+
+#endif
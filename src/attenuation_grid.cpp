@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <unordered_map>
+
+#include "../headers/attenuation_grid.hpp"
+
+AttenuationGrid::AttenuationGrid(const Room& room)
+: width(room.width), height(room.height), cells(static_cast<size_t>(room.width) * room.height, 0), sets(1) {
+    std::map<std::vector<uint32_t>, uint32_t> known;
+    known[sets[0]] = 0;
+    for (const Emitter& emitter : room.emitters) emitterPositions.push_back({emitter.getX(), emitter.getY()});
+
+    for (size_t k = 0; k < room.obstacles.size(); k++) {
+        const Obstacle* obstacle = room.obstacles[k];
+        attenuations.push_back(obstacle->getAttenuation());
+        obstacles.push_back(obstacle);
+        // MurDroit::isBlocking ne teste que les faces longitudinales (un rayon qui entre par une
+        // extrémité n'est pas bloqué) : toutes ses cellules sont vérifiées, pour rester identique
+        const bool trustInterior = dynamic_cast<const MurDroit*>(obstacle) == nullptr;
+
+        double min_x, min_y, max_x, max_y;
+        obstacle->getExpandedBounds(min_x, min_y, max_x, max_y);
+        const int x0 = std::max(0, static_cast<int>(std::floor(min_x)) - 1);
+        const int x1 = std::min(width - 1, static_cast<int>(std::ceil(max_x)) + 1);
+        const int y0 = std::max(0, static_cast<int>(std::floor(min_y)) - 1);
+        const int y1 = std::min(height - 1, static_cast<int>(std::ceil(max_y)) + 1);
+
+        // Ensemble de la cellule (et type de cellule) avant l'ajout de cet obstacle -> ensemble après
+        std::unordered_map<uint64_t, uint32_t> next;
+        for (int y = y0; y <= y1; y++) {
+            for (int x = x0; x <= x1; x++) {
+                // Toute cellule recouverte, même sans centre ni coin dedans (extrémité d'un mur en biais)
+                if (!obstacle->overlapsBox(x - 0.5, y - 0.5, x + 0.5, y + 0.5)) continue;
+                const int corners = obstacle->isPointInside(x - 0.5, y - 0.5) + obstacle->isPointInside(x + 0.5, y - 0.5) +
+                                    obstacle->isPointInside(x - 0.5, y + 0.5) + obstacle->isPointInside(x + 0.5, y + 0.5);
+                // Obstacles convexes : les quatre coins dedans, toute la cellule est dedans
+                const bool interior = trustInterior && corners == 4;
+                const uint32_t entry = static_cast<uint32_t>(k) | (interior ? INTERIOR : 0);
+
+                uint32_t& cell = cells[static_cast<size_t>(y) * width + x];
+                const uint64_t key = static_cast<uint64_t>(cell) << 1 | interior;
+                auto it = next.find(key);
+                if (it == next.end()) {
+                    std::vector<uint32_t> set = sets[cell];
+                    set.push_back(entry);
+                    auto found = known.find(set);
+                    uint32_t id;
+                    if (found != known.end()) {
+                        id = found->second;
+                    } else {
+                        id = static_cast<uint32_t>(sets.size());
+                        known[set] = id;
+                        sets.push_back(set);
+                    }
+                    it = next.emplace(key, id).first;
+                }
+                cell = it->second;
+            }
+        }
+    }
+}
+
+double AttenuationGrid::occlusion(double emitter_x, double emitter_y, int x, int y, std::vector<uint32_t>& scratch) const {
+    // scratch : obstacles comptés (indice) ou seulement effleurés, à vérifier (indice | PENDING)
+    scratch.clear();
+    double total = 0.0;
+    uint32_t previous = 0;
+
+    auto visit = [&](int cx, int cy) {
+        const uint32_t id = cells[static_cast<size_t>(cy) * width + cx];
+        if (id == 0 || id == previous) {
+            previous = id;
+            return;
+        }
+        previous = id;
+        for (uint32_t entry : sets[id]) {
+            const uint32_t k = entry & ~INTERIOR;
+            auto it = std::find_if(scratch.begin(), scratch.end(), [k](uint32_t s) { return (s & ~PENDING) == k; });
+            if (it != scratch.end() && *it == k) continue; // Déjà compté
+            if (entry & INTERIOR) {
+                // Le rayon traverse une cellule entièrement dans l'obstacle : il est bloqué
+                if (it != scratch.end()) *it = k;
+                else scratch.push_back(k);
+                total += attenuations[k];
+            } else if (it == scratch.end()) {
+                scratch.push_back(k | PENDING);
+            }
+        }
+    };
+
+    // Coordonnées décalées d'un demi-pixel : la cellule (i, j) devient [i, i+1) x [j, j+1)
+    const double ux = emitter_x + 0.5, uy = emitter_y + 0.5;
+    int cx = std::min(width - 1, std::max(0, static_cast<int>(std::floor(ux))));
+    int cy = std::min(height - 1, std::max(0, static_cast<int>(std::floor(uy))));
+    const double dx = x - emitter_x, dy = y - emitter_y;
+    const int stepX = dx > 0 ? 1 : -1, stepY = dy > 0 ? 1 : -1;
+    const double inf = std::numeric_limits<double>::infinity();
+    const double deltaX = dx != 0 ? 1.0 / std::abs(dx) : inf;
+    const double deltaY = dy != 0 ? 1.0 / std::abs(dy) : inf;
+    double tMaxX = dx != 0 ? (dx > 0 ? cx + 1 - ux : ux - cx) * deltaX : inf;
+    double tMaxY = dy != 0 ? (dy > 0 ? cy + 1 - uy : uy - cy) * deltaY : inf;
+
+    // Nombre de pas fixé par les cellules de départ et d'arrivée : aucune dérive d'arrondi
+    int stepsX = std::abs(x - cx), stepsY = std::abs(y - cy);
+    visit(cx, cy);
+    while (stepsX > 0 || stepsY > 0) {
+        if (stepsY == 0 || (stepsX > 0 && tMaxX < tMaxY)) {
+            cx += stepX;
+            tMaxX += deltaX;
+            stepsX--;
+        } else {
+            cy += stepY;
+            tMaxY += deltaY;
+            stepsY--;
+        }
+        visit(cx, cy);
+    }
+
+    // Obstacles seulement effleurés : test exact, limité aux bords rencontrés par le rayon
+    for (uint32_t s : scratch) {
+        if (s & PENDING) {
+            const uint32_t k = s & ~PENDING;
+            if (obstacles[k]->isBlocking(x, y, emitter_x, emitter_y)) total += attenuations[k];
+        }
+    }
+    return total;
+}
+
+size_t AttenuationGrid::coveredCells() const {
+    return static_cast<size_t>(std::count_if(cells.begin(), cells.end(), [](uint32_t id) { return id != 0; }));
+}
@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+#include "../headers/channel_planner.hpp"
+#include "../headers/parallel.hpp"
+
+namespace {
+
+const int UNASSIGNED = -1;
+
+// Contribution d'un émetteur en un point d'évaluation, en mW
+struct Contribution {
+    uint32_t sample;
+    double milliwatts;
+};
+
+/**
+ * État d'un plan : canal de chaque émetteur, somme par canal de l'interférence de chaque point
+ * (émetteurs affectés hors meilleur), et nombre de points interférés
+ */
+struct PlanState {
+    int channels;
+    std::vector<int> best;               // Meilleur émetteur de chaque point
+    std::vector<double> bestMilliwatts;  // Sa puissance
+    std::vector<std::vector<Contribution>> touched; // Par émetteur : points où il sert ou interfère
+    double noiseMilliwatts, minSinr;     // minSinr en rapport linéaire
+
+    std::vector<int> channel;
+    std::vector<double> sums;            // sums[s·channels + c]
+    long interfered = 0;
+
+    bool isInterfered(size_t s, double interference) const {
+        return bestMilliwatts[s] < minSinr * (interference + noiseMilliwatts);
+    }
+
+    // Variation du nombre de points interférés si l'émetteur e passe sur le canal to
+    long moveDelta(size_t e, int to) const {
+        const int from = channel[e];
+        long delta = 0;
+        for (const Contribution& c : touched[e]) {
+            const size_t s = c.sample;
+            const double* sum = &sums[s * channels];
+            if (best[s] == static_cast<int>(e)) {
+                // L'émetteur sert ce point : il subit l'interférence de son nouveau canal
+                delta += isInterfered(s, sum[to]) - (from != UNASSIGNED && isInterfered(s, sum[from]));
+                continue;
+            }
+            const int served = channel[best[s]];
+            if (served == UNASSIGNED || (from != served && to != served)) continue;
+            const double after = sum[served] + (to == served ? c.milliwatts : -c.milliwatts);
+            delta += isInterfered(s, after) - isInterfered(s, sum[served]);
+        }
+        return delta;
+    }
+
+    void move(size_t e, int to) {
+        interfered += moveDelta(e, to);
+        const int from = channel[e];
+        for (const Contribution& c : touched[e]) {
+            if (best[c.sample] == static_cast<int>(e)) continue;
+            double* sum = &sums[c.sample * channels];
+            if (from != UNASSIGNED) sum[from] -= c.milliwatts;
+            sum[to] += c.milliwatts;
+        }
+        channel[e] = to;
+    }
+};
+
+} // namespace
+
+ChannelPlanResult planChannels(const Room& room, const ChannelPlanOptions& options) {
+    const auto start = std::chrono::steady_clock::now();
+    ChannelPlanResult result;
+    const size_t emitterCount = room.emitters.size();
+    if (room.emitterLayers.size() != emitterCount || emitterCount == 0 || options.channels <= 0) {
+        std::cerr << "Plan de canaux impossible : couches par emetteur absentes (keepEmitterLayers)" << std::endl;
+        return result;
+    }
+    const std::vector<size_t> samples = room.samplePoints(std::max(1, options.downsample));
+    if (samples.empty()) return result;
+
+    // Puissance de chaque émetteur en chaque point, lue dans sa couche (voir EmitterLayer)
+    std::vector<double> offsets(emitterCount);
+    for (size_t e = 0; e < emitterCount; e++) offsets[e] = room.layerOffset(e);
+    auto receivedPower = [&](size_t e, size_t pixel) { return room.layerPower(e, pixel, offsets[e]); };
+
+    PlanState state;
+    state.channels = options.channels;
+    state.noiseMilliwatts = std::pow(10.0, options.noise / 10);
+    state.minSinr = std::pow(10.0, options.minSinr / 10);
+    state.best.assign(samples.size(), UNASSIGNED);
+    state.bestMilliwatts.assign(samples.size(), 0.0);
+    parallelFor(static_cast<int>(samples.size()), options.threads, [&](int s) {
+        double best = Room::NOISE_FLOOR;
+        for (size_t e = 0; e < emitterCount; e++) {
+            const double power = receivedPower(e, samples[s]);
+            if (power > best) {
+                best = power;
+                state.best[s] = static_cast<int>(e);
+            }
+        }
+        if (best < options.threshold) state.best[s] = UNASSIGNED; // Point non servi, hors évaluation
+        else state.bestMilliwatts[s] = std::pow(10.0, best / 10);
+    });
+
+    // Points servis touchés par chaque émetteur (interférences sous le plancher négligées)
+    long served = 0;
+    state.touched.resize(emitterCount);
+    std::vector<long> servedBy(emitterCount, 0);
+    for (size_t s = 0; s < samples.size(); s++) {
+        if (state.best[s] == UNASSIGNED) continue;
+        served++;
+        servedBy[state.best[s]]++;
+        for (size_t e = 0; e < emitterCount; e++) {
+            const double power = receivedPower(e, samples[s]);
+            if (static_cast<int>(e) == state.best[s] || power >= Room::NOISE_FLOOR) {
+                state.touched[e].push_back({static_cast<uint32_t>(s), std::pow(10.0, power / 10)});
+            }
+        }
+    }
+    state.channel.assign(emitterCount, UNASSIGNED);
+    state.sums.assign(samples.size() * options.channels, 0.0);
+
+    // Affectation gloutonne : émetteurs par surface servie décroissante, chacun sur le canal
+    // qui interfère le moins avec ceux déjà placés
+    std::vector<size_t> order(emitterCount);
+    for (size_t e = 0; e < emitterCount; e++) order[e] = e;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return servedBy[a] > servedBy[b]; });
+    std::vector<long> deltas(options.channels);
+    for (size_t e : order) {
+        parallelFor(options.channels, options.threads, [&](int c) { deltas[c] = state.moveDelta(e, c); });
+        result.evaluations += options.channels;
+        state.move(e, static_cast<int>(std::min_element(deltas.begin(), deltas.end()) - deltas.begin()));
+    }
+
+    // Recherche locale : meilleur changement de canal d'un émetteur, tant qu'il améliore le plan
+    struct Move { size_t emitter; int channel; long delta; };
+    std::vector<Move> moves;
+    for (size_t e = 0; e < emitterCount; e++) {
+        for (int c = 0; c < options.channels; c++) moves.push_back({e, c, 0});
+    }
+    for (int it = 0; it < options.iterations && state.interfered > 0; it++) {
+        parallelFor(static_cast<int>(moves.size()), options.threads, [&](int m) {
+            const Move& move = moves[m];
+            moves[m].delta = state.channel[move.emitter] == move.channel ? 0 : state.moveDelta(move.emitter, move.channel);
+        });
+        result.evaluations += static_cast<long>(moves.size());
+        const Move& move = *std::min_element(moves.begin(), moves.end(),
+                                             [](const Move& a, const Move& b) { return a.delta < b.delta; });
+        if (move.delta >= 0) break; // Optimum local
+        state.move(move.emitter, move.channel);
+    }
+
+    result.channels = state.channel;
+    result.servedArea = static_cast<double>(served) / samples.size();
+    result.interferedArea = served > 0 ? static_cast<double>(state.interfered) / served : 0.0;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Plan de " << options.channels << " canaux pour " << emitterCount << " emetteur(s): "
+              << 100.0 * result.interferedArea << "% des points servis interferes (" << result.evaluations
+              << " affectations evaluees en " << result.seconds << " s)" << std::endl;
+    return result;
+}
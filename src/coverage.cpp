@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+#include "../headers/coverage.hpp"
+#include "../headers/parallel.hpp"
+#include "../headers/occlusion_engine.hpp"
+
+void ZoneStatistics::add(double power, bool aboveThreshold) {
+    if (count == 0) min = max = power;
+    min = std::min(min, power);
+    max = std::max(max, power);
+    sum += power;
+    if (aboveThreshold) covered++;
+    count++;
+}
+
+void ZoneStatistics::merge(const ZoneStatistics& other) {
+    if (other.count == 0) return;
+    if (count == 0) {
+        min = other.min;
+        max = other.max;
+    }
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+    sum += other.sum;
+    covered += other.covered;
+    count += other.count;
+}
+
+CoverageStatistics::CoverageStatistics(const CoverageOptions& options)
+: histogramMin(options.histogramMin), binWidth(options.binWidth),
+  histogram(std::max(1, static_cast<int>(std::ceil((options.histogramMax - options.histogramMin) / options.binWidth))), 0),
+  zones(options.zones.size()) {}
+
+void CoverageStatistics::merge(const CoverageStatistics& other) {
+    for (size_t b = 0; b < histogram.size(); b++) histogram[b] += other.histogram[b];
+    all.merge(other.all);
+    for (size_t z = 0; z < zones.size(); z++) zones[z].merge(other.zones[z]);
+}
+
+double CoverageStatistics::percentile(double p) const {
+    if (all.count == 0) return 0.0;
+    const double rank = std::clamp(p, 0.0, 100.0) / 100.0 * all.count;
+    long cumulative = 0;
+    for (size_t b = 0; b < histogram.size(); b++) {
+        if (histogram[b] > 0 && cumulative + histogram[b] >= rank) {
+            const double fraction = (rank - cumulative) / histogram[b];
+            const double value = histogramMin + (b + fraction) * binWidth;
+            return std::clamp(value, all.min, all.max); // Classes extrêmes ouvertes
+        }
+        cumulative += histogram[b];
+    }
+    return all.max;
+}
+
+bool CoverageStatistics::exportHistogram(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file) {
+        std::cerr << "Erreur d'ouverture du fichier !" << std::endl;
+        return false;
+    }
+    file << "dbm,points\n";
+    for (size_t b = 0; b < histogram.size(); b++) {
+        file << histogramMin + b * binWidth << "," << histogram[b] << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+namespace {
+
+// Ajoute un point libre à l'accumulateur d'une tuile
+void accumulate(CoverageStatistics& stats, const CoverageOptions& options, int x, int y, double power) {
+    const bool above = power >= options.threshold;
+    const int bin = static_cast<int>(std::floor((power - stats.histogramMin) / stats.binWidth));
+    stats.histogram[std::clamp(bin, 0, static_cast<int>(stats.histogram.size()) - 1)]++;
+    stats.all.add(power, above);
+    for (size_t z = 0; z < options.zones.size(); z++) {
+        const Tile& area = options.zones[z].area;
+        if (x >= area.x0 && x < area.x1 && y >= area.y0 && y < area.y1) stats.zones[z].add(power, above);
+    }
+}
+
+} // namespace
+
+CoverageStatistics computeCoverageStatistics(const Room& room, const CoverageOptions& options) {
+    const std::vector<Tile> grid = room.tiles();
+    std::vector<CoverageStatistics> partial(grid.size(), CoverageStatistics(options));
+    std::unique_ptr<OcclusionEngine> occlusion = room.prepareEngineGroup(0);
+    const bool bounded = room.obstaclesOnlyAttenuate();
+
+    // Moteur polaire en plusieurs groupes d'émetteurs (comme Room::computeSignalMap) : maximum des
+    // groupes précédant le dernier gardé par tuile, 8 octets par point, moins que la grille polaire
+    // d'un seul émetteur
+    std::vector<std::vector<double>> groupMaxima;
+    while (occlusion && occlusion->endEmitter < room.emitters.size()) {
+        groupMaxima.resize(grid.size());
+        parallelFor(static_cast<int>(grid.size()), room.threads, [&](int i) {
+            const Tile& tile = grid[i];
+            const int columns = tile.x1 - tile.x0;
+            std::vector<double> power(static_cast<size_t>(columns) * (tile.y1 - tile.y0));
+            room.computeTilePower(tile, occlusion.get(), bounded, power.data(), columns);
+            std::vector<double>& maxima = groupMaxima[i];
+            if (maxima.empty()) maxima = std::move(power);
+            else for (size_t k = 0; k < maxima.size(); k++) maxima[k] = std::max(maxima[k], power[k]);
+        });
+        const size_t next = occlusion->endEmitter;
+        occlusion.reset(); // Grilles du groupe précédent libérées avant de préparer le suivant
+        occlusion = room.prepareEngineGroup(next);
+    }
+
+    parallelFor(static_cast<int>(grid.size()), room.threads, [&](int i) {
+        const Tile& tile = grid[i];
+        CoverageStatistics& stats = partial[i];
+
+        const std::vector<const Obstacle*> nearby = room.obstaclesTouching(tile);
+        const int columns = tile.x1 - tile.x0;
+        std::vector<double> power(static_cast<size_t>(columns) * (tile.y1 - tile.y0));
+        room.computeTilePower(tile, occlusion.get(), bounded, power.data(), columns);
+        if (!groupMaxima.empty()) {
+            for (size_t k = 0; k < power.size(); k++) power[k] = std::max(power[k], groupMaxima[i][k]);
+            std::vector<double>().swap(groupMaxima[i]);
+        }
+        for (int y = tile.y0; y < tile.y1; y++) {
+            for (int x = tile.x0; x < tile.x1; x++) {
+                if (room.isMarkedAsObstacle(x, y, nearby)) continue;
+                accumulate(stats, options, x, y, power[static_cast<size_t>(y - tile.y0) * columns + (x - tile.x0)]);
+            }
+        }
+    });
+
+    CoverageStatistics result(options);
+    for (const auto& stats : partial) result.merge(stats);
+    return result;
+}
+
+CoverageStatistics coverageStatisticsFromMap(PowerMapReader& reader, const CoverageOptions& options) {
+    CoverageStatistics result(options);
+    std::vector<double> row(reader.mapWidth());
+    for (int y = 0; y < reader.mapHeight(); y++) {
+        reader.readRow(y, 0, reader.mapWidth(), row.data());
+        for (int x = 0; x < reader.mapWidth(); x++) {
+            if (row[x] != -555) accumulate(result, options, x, y, row[x]);
+        }
+    }
+    return result;
+}
@@ -16,6 +16,12 @@
 
 #define CELL_SIZE 1 // Taille de la cellule de la grille
 #define CLICK_THRESHOLD 30 // Seuil de distance pour détecter un clic sur un émetteur
+#define POWER_STEP 1.0 // Pas de réglage de la puissance d'un émetteur (dB)
+#define MAX_VIEW_WIDTH 1600 // Taille maximale de la fenêtre de displayingMap (pixels)
+#define MAX_VIEW_HEIGHT 900
+
+// Fréquences proposées pour un émetteur sélectionné (flèches gauche/droite)
+static const double FREQUENCY_CHOICES[] = {2.4e9, 5e9, 6e9};
 
 // Fonction pour charger les données de puissance WiFi depuis un CSV
 std::vector<std::vector<double>> loadCSV(const std::string& filename) {
@@ -78,21 +84,32 @@ SDL_Color dBmToColor(double power, double min_power, double max_power) {
     return color;
 }
 
+SDL_Color throughputToColor(double rate, double max_rate) {
+    if (rate <= 0) return {64, 64, 64, 255}; // Point non servi
+    return dBmToColor(rate, 0.0, max_rate);
+}
+
 int handlepowerMap(Room* room, SDL_Renderer* renderer){
-    if ((*room).powerMap.empty()) {
+    if (!(*room).hasPowerMap()) {
         std::cerr << "Aucune donnee n'a ete chargee" << std::endl;
         return 1;
     }
-    
-    int gridHeight = (*room).powerMap.size();
-    int gridWidth = (*room).powerMap[0].size();
+    return drawPowerMap(*(*room).mapReader(), renderer);
+}
+
+int drawPowerMap(PowerMapReader& reader, SDL_Renderer* renderer, int step){
+    int gridHeight = reader.mapHeight();
+    int gridWidth = reader.mapWidth();
+    std::vector<double> row(gridWidth);
     
     // Trouver les valeurs min et max
     double minPower = std::numeric_limits<double>::max();
     double maxPower = std::numeric_limits<double>::lowest();
     
-    for (const auto& row : (*room).powerMap) {
-        for (double val : row) {
+    for (int y = 0; y < gridHeight; y += step) {
+        reader.readRow(y, 0, gridWidth, row.data());
+        for (int x = 0; x < gridWidth; x += step) {
+            double val = row[x];
             if (!std::isnan(val) && val != -555) {
                 minPower = std::min(minPower, val);
                 maxPower = std::max(maxPower, val);
@@ -102,20 +119,13 @@ int handlepowerMap(Room* room, SDL_Renderer* renderer){
     
     std::cout << "Puissance min: " << minPower << " dBm, max: " << maxPower << " dBm" << std::endl;
 
-    // Remplacer les NaN par la valeur minimale
-    for (auto& row : (*room).powerMap) {
-        for (auto& val : row) {
-            if (std::isnan(val)) {
-                val = minPower;
-            }
-        }
-    }
-
     // Dessiner la heatmap
-    for (int y = 0; y < gridHeight; y++) {
-        for (int x = 0; x < gridWidth; x++) {
+    for (int y = 0; y < gridHeight; y += step) {
+        reader.readRow(y, 0, gridWidth, row.data());
+        for (int x = 0; x < gridWidth; x += step) {
             //SDL_Color color = dBmToColor((*powerMap)[y][x], minPower, maxPower);
-            double val = (*room).powerMap[y][x];
+            double val = row[x];
+            if (std::isnan(val)) val = minPower; // Les NaN prennent la valeur minimale
             SDL_Color color;
             if (val == -555) {
                 color = {0, 0, 0, 255}; // noir
@@ -125,8 +135,8 @@ int handlepowerMap(Room* room, SDL_Renderer* renderer){
             SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
             
             SDL_Rect rect = {
-                x * CELL_SIZE,
-                y * CELL_SIZE,
+                x / step * CELL_SIZE,
+                y / step * CELL_SIZE,
                 CELL_SIZE,
                 CELL_SIZE
             };
@@ -137,6 +147,107 @@ int handlepowerMap(Room* room, SDL_Renderer* renderer){
     return 0;
 }
 
+int displayingMap(PowerMapReader& reader) {
+    const int gridWidth = reader.mapWidth();
+    const int gridHeight = reader.mapHeight();
+    // Un point affiché sur step : la fenêtre tient à l'écran quelle que soit la taille de la carte
+    const int step = std::max({1, (gridWidth * CELL_SIZE + MAX_VIEW_WIDTH - 1) / MAX_VIEW_WIDTH,
+                                  (gridHeight * CELL_SIZE + MAX_VIEW_HEIGHT - 1) / MAX_VIEW_HEIGHT});
+
+    if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+        std::cerr << "Erreur d'initialisation SDL: " << SDL_GetError() << std::endl;
+        return 1;
+    }
+    SDL_Window* window = SDL_CreateWindow(
+        "Carte thermique du signal WiFi (dBm)",
+        SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
+        (gridWidth + step - 1) / step * CELL_SIZE, (gridHeight + step - 1) / step * CELL_SIZE,
+        SDL_WINDOW_SHOWN
+    );
+    if (!window) {
+        std::cerr << "Erreur de creation de fenêtre: " << SDL_GetError() << std::endl;
+        SDL_Quit();
+        return 1;
+    }
+    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    if (!renderer) {
+        std::cerr << "Erreur de creation du renderer: " << SDL_GetError() << std::endl;
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return 1;
+    }
+
+    if (step > 1) std::cout << "Carte reduite : un point sur " << step << " affiche" << std::endl;
+    drawPowerMap(reader, renderer, step);
+    SDL_RenderPresent(renderer);
+
+    bool running = true;
+    SDL_Event event;
+    while (running && SDL_WaitEvent(&event)) {
+        if (event.type == SDL_QUIT) {
+            running = false;
+        }
+        else if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_ESCAPE) {
+            running = false;
+        }
+        else if (event.type == SDL_MOUSEBUTTONDOWN && event.button.button == SDL_BUTTON_LEFT) {
+            // Point de la carte sous le clic, lu par le lecteur (sa tuile est calculée au besoin)
+            const int x = event.button.x / CELL_SIZE * step;
+            const int y = event.button.y / CELL_SIZE * step;
+            if (x >= 0 && x < gridWidth && y >= 0 && y < gridHeight) {
+                double signalPower;
+                reader.readRow(y, x, x + 1, &signalPower);
+                std::cout << "Clic a la position: (" << x << ", " << y << ")" << std::endl;
+                if (signalPower == -555) std::cout << "Obstacle" << std::endl;
+                else std::cout << "Puissance du signal: " << signalPower << " dBm" << std::endl;
+            }
+        }
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+    return 0;
+}
+
+int drawThroughputMap(Room* room, const ThroughputTable& table, ServingMapsCache& cache, SDL_Renderer* renderer) {
+    if (!(*room).hasPowerMap()) {
+        std::cerr << "Aucune donnee n'a ete chargee" << std::endl;
+        return 1;
+    }
+    // Débits tirés du SINR dans la passe des cartes de desserte, refaite après toute modification
+    // des émetteurs, des obstacles ou des matériaux (hash de la scène)
+    const uint64_t hash = (*room).sceneHash();
+    if (!cache.valid || cache.sceneHash != hash) {
+        cache.maps = (*room).computeServingMaps(Room::THERMAL_NOISE, &table);
+        cache.sceneHash = hash;
+        cache.valid = true;
+    }
+    const ServingMaps& serving = cache.maps;
+    const double maxRate = table.maxRate();
+
+    double meanRate = 0.0;
+    long points = 0; // Points hors obstacles, seuls comptés dans la moyenne
+    for (int y = 0; y < (*room).height; y++) {
+        for (int x = 0; x < (*room).width; x++) {
+            SDL_Color color;
+            if ((*room).getPower(x, y) == -555) {
+                color = {0, 0, 0, 255}; // noir
+            } else {
+                color = throughputToColor(serving.throughput[y][x], maxRate);
+                meanRate += serving.throughput[y][x];
+                points++;
+            }
+            SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+            SDL_Rect rect = {x * CELL_SIZE, y * CELL_SIZE, CELL_SIZE, CELL_SIZE};
+            SDL_RenderFillRect(renderer, &rect);
+        }
+    }
+    std::cout << "Debit moyen: " << (points > 0 ? meanRate / points : 0.0) << " Mb/s (max " << maxRate
+              << " Mb/s)" << std::endl;
+    return 0;
+}
+
 SDL_Texture* renderText(SDL_Renderer* renderer, TTF_Font* font, const char* text, SDL_Color textColor) {
     SDL_Surface* textSurface = TTF_RenderText_Blended(font, text, textColor);
     if (!textSurface) {
@@ -173,8 +284,8 @@ int displaying(Room* room) {
     }
     
 
-    int gridHeight = (*room).powerMap.size();
-    int gridWidth = (*room).powerMap[0].size();
+    int gridHeight = (*room).height;
+    int gridWidth = (*room).width;
     
     // Initialiser SDL
     if (SDL_Init(SDL_INIT_VIDEO) != 0) {
@@ -206,7 +317,16 @@ int displaying(Room* room) {
         return 1;
     }
 
-    handlepowerMap(room, renderer); 
+    // Carte affichée : puissance (dBm) ou débit attendu (touche T)
+    ThroughputTable throughputTable;
+    ServingMapsCache servingCache;
+    bool showThroughput = false;
+    auto drawMap = [&]() {
+        return showThroughput ? drawThroughputMap(room, throughputTable, servingCache, renderer)
+                              : handlepowerMap(room, renderer);
+    };
+
+    drawMap();
 
     SDL_RenderPresent(renderer);
 
@@ -253,9 +373,49 @@ int displaying(Room* room) {
                 running = false;
             }
             else if (event.type == SDL_KEYDOWN) {
-                if (event.key.keysym.sym == SDLK_ESCAPE) {
+                SDL_Keycode key = event.key.keysym.sym;
+                if (key == SDLK_ESCAPE) {
                     running = false;
                 }
+                else if (key == SDLK_t) {
+                    showThroughput = !showThroughput;
+                    drawMap();
+                    SDL_RenderPresent(renderer);
+                }
+                // Réglage de l'émetteur sélectionné : flèches haut/bas pour la puissance,
+                // gauche/droite pour la fréquence. Seul le décalage de sa couche change,
+                // la carte est recombinée sans recalcul des obstacles
+                else if (emitterSelected && (key == SDLK_UP || key == SDLK_DOWN || key == SDLK_LEFT || key == SDLK_RIGHT)) {
+                    size_t index = selectedEmitter - &(*room).emitters[0];
+                    if (!(*room).keepEmitterLayers) {
+                        (*room).keepEmitterLayers = true;
+                        (*room).computeSignalMap();
+                    }
+
+                    if (key == SDLK_UP || key == SDLK_DOWN) {
+                        double step = (key == SDLK_UP) ? POWER_STEP : -POWER_STEP;
+                        (*room).setEmitterPower(index, (*selectedEmitter).power + step);
+                    } else {
+                        const int count = sizeof(FREQUENCY_CHOICES) / sizeof(FREQUENCY_CHOICES[0]);
+                        int current = 0;
+                        for (int i = 0; i < count; i++) {
+                            if (std::abs(FREQUENCY_CHOICES[i] - (*selectedEmitter).frequency) <
+                                std::abs(FREQUENCY_CHOICES[current] - (*selectedEmitter).frequency)) {
+                                current = i;
+                            }
+                        }
+                        current = (current + (key == SDLK_RIGHT ? 1 : count - 1)) % count;
+                        (*room).setEmitterFrequency(index, FREQUENCY_CHOICES[current]);
+                    }
+                    (*room).markObstaclesOnPowerMap();
+
+                    std::cout << "Emetteur (" << (*selectedEmitter).getX() << ", " << (*selectedEmitter).getY()
+                              << "): " << (*selectedEmitter).power << " dBm, "
+                              << (*selectedEmitter).frequency / 1e9 << " GHz" << std::endl;
+
+                    drawMap();
+                    SDL_RenderPresent(renderer);
+                }
             }
             else if (event.type == SDL_MOUSEBUTTONDOWN) {
                 if (event.button.button == SDL_BUTTON_LEFT) {
@@ -292,12 +452,18 @@ int displaying(Room* room) {
                                 int wallEndY = clickY;
                                 
                                 // Ajouter le mur
-                                (*room).addObstacle(new Mur(wallStartX, wallStartY, wallEndX, wallEndY, 10, 5));
+                                Mur* wall = new Mur(wallStartX, wallStartY, wallEndX, wallEndY, 10, 5);
+                                (*room).addObstacle(wall);
                                 std::cout << "Mur ajouté de (" << wallStartX << ", " << wallStartY << ") à (" 
                                             << wallEndX << ", " << wallEndY << ")" << std::endl;
                                 
-                                // Recalculer la carte
-                                (*room).computeSignalMap();
+                                // Recalculer la carte (seuls les points masqués par le mur si les couches sont conservées)
+                                if ((*room).keepEmitterLayers) {
+                                    (*room).applyObstacleToLayers(wall, 1.0);
+                                    (*room).combineEmitterLayers();
+                                } else {
+                                    (*room).computeSignalMap();
+                                }
                                 (*room).markObstaclesOnPowerMap();
                                 
                                 // Réinitialiser le mode d'ajout de mur
@@ -305,7 +471,7 @@ int displaying(Room* room) {
                                 waitingForSecondPoint = false;
                                 
                                 // mise à jour de la power map
-                                handlepowerMap(room, renderer); 
+                                drawMap();
                             }
                         }
                     }
@@ -318,7 +484,7 @@ int displaying(Room* room) {
                         if (lastClickX >= 0 && lastClickX < gridWidth && 
                             lastClickY >= 0 && lastClickY < gridHeight) {
                             
-                            double signalPower = (*room).powerMap[lastClickY][lastClickX];
+                            double signalPower = (*room).getPower(lastClickX, lastClickY);
                             
                             std::cout << "Clic a la position: (" << lastClickX << ", " 
                                     << lastClickY << ")" << std::endl;
@@ -337,7 +503,13 @@ int displaying(Room* room) {
                                         << (*selectedEmitter).getY() << ")" << std::endl;
                                 
                                 // Mettre à jour la carte de puissance
-                                (*room).computeSignalMap(); // Recalculer la carte de puissance
+                                if ((*room).keepEmitterLayers) {
+                                    // Seule la couche de l'émetteur déplacé est recalculée
+                                    (*room).computeEmitterLayer(selectedEmitter - &(*room).emitters[0]);
+                                    (*room).combineEmitterLayers();
+                                } else {
+                                    (*room).computeSignalMap(); // Recalculer la carte de puissance
+                                }
                                 (*room).markObstaclesOnPowerMap();
                                 
                                 emitterSelected = false; // Réinitialiser l'état de sélection
@@ -365,7 +537,7 @@ int displaying(Room* room) {
                                 }
                             }
                             
-                            handlepowerMap(room, renderer); 
+                            drawMap();
 
                             // Dessiner un marqueur sur la position du clic
                             SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255); // blanc
@@ -421,7 +593,7 @@ int displaying(Room* room) {
                                 char buffer[128];
                                 
                                 if (lastClickX >= 0 && lastClickX < gridWidth && lastClickY >= 0 && lastClickY < gridHeight) {
-                                    double signalPower = (*room).powerMap[lastClickY][lastClickX];
+                                    double signalPower = (*room).getPower(lastClickX, lastClickY);
                                     
                                     // Formater le texte avec les informations de puissance
                                     if (signalPower == -555) {
@@ -0,0 +1,486 @@
+#include <cmath>
+#include <cstdlib>
+#include <cctype>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+
+#include "../headers/floorplan.hpp"
+#include "../headers/obstacle.hpp"
+
+namespace {
+
+// Applique échelle, inversion et translation à un point du fichier
+void transformPoint(const FloorplanImportOptions& options, double& x, double& y) {
+    x = x * options.scale + options.offsetX;
+    y = (options.flipY ? -y : y) * options.scale + options.offsetY;
+}
+
+void pushSegment(std::vector<WallSegment>& out, const FloorplanImportOptions& options,
+                 double x1, double y1, double x2, double y2, double thickness, double attenuation) {
+    transformPoint(options, x1, y1);
+    transformPoint(options, x2, y2);
+    out.push_back({x1, y1, x2, y2, thickness, attenuation});
+}
+
+double layerAttenuation(const FloorplanImportOptions& options, const std::string& layer) {
+    auto it = options.layerAttenuation.find(layer);
+    return it != options.layerAttenuation.end() ? it->second : options.attenuation;
+}
+
+std::string toLower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return std::tolower(c); });
+    return s;
+}
+
+/////////////////////////////// SVG ///////////////////////////////
+
+// Extrait la valeur d'un attribut XML (guillemets simples ou doubles), "" si absent
+std::string svgAttribute(const std::string& tag, const std::string& name) {
+    size_t pos = 0;
+    while ((pos = tag.find(name, pos)) != std::string::npos) {
+        bool boundary = pos > 0 && std::isspace(static_cast<unsigned char>(tag[pos - 1]));
+        size_t eq = pos + name.size();
+        while (eq < tag.size() && std::isspace(static_cast<unsigned char>(tag[eq]))) eq++;
+        if (boundary && eq < tag.size() && tag[eq] == '=') {
+            size_t quote = tag.find_first_of("\"'", eq);
+            if (quote == std::string::npos) return "";
+            size_t end = tag.find(tag[quote], quote + 1);
+            if (end == std::string::npos) return "";
+            return tag.substr(quote + 1, end - quote - 1);
+        }
+        pos += name.size();
+    }
+    return "";
+}
+
+// Lit une suite de nombres séparés par des espaces ou des virgules
+std::vector<double> svgNumbers(const std::string& text) {
+    std::vector<double> values;
+    const char* p = text.c_str();
+    while (*p) {
+        char* end = nullptr;
+        double v = std::strtod(p, &end);
+        if (end == p) { p++; continue; }
+        values.push_back(v);
+        p = end;
+    }
+    return values;
+}
+
+// Épaisseur de trait : attribut stroke-width ou propriété du style
+double svgStrokeWidth(const std::string& tag, const FloorplanImportOptions& options) {
+    std::string width = svgAttribute(tag, "stroke-width");
+    if (width.empty()) {
+        std::string style = svgAttribute(tag, "style");
+        size_t pos = style.find("stroke-width:");
+        if (pos != std::string::npos) width = style.substr(pos + 13);
+    }
+    if (width.empty()) return options.thickness;
+    double w = std::strtod(width.c_str(), nullptr);
+    return w > 0 ? w * options.scale : options.thickness;
+}
+
+// Chemin SVG : seules les commandes M, L, H, V, Z sont exactes,
+// les courbes sont remplacées par la corde jusqu'à leur point final
+void svgPathSegments(const std::string& d, std::vector<WallSegment>& out, const FloorplanImportOptions& options,
+                     double thickness, double attenuation) {
+    double cx = 0, cy = 0, sx = 0, sy = 0;
+    char command = 0;
+    const char* p = d.c_str();
+
+    auto readNumber = [&p](double& v) {
+        while (*p && (std::isspace(static_cast<unsigned char>(*p)) || *p == ',')) p++;
+        char* end = nullptr;
+        v = std::strtod(p, &end);
+        if (end == p) return false;
+        p = end;
+        return true;
+    };
+
+    while (*p) {
+        if (std::isalpha(static_cast<unsigned char>(*p))) {
+            command = *p++;
+            if (command == 'Z' || command == 'z') {
+                if (cx != sx || cy != sy) pushSegment(out, options, cx, cy, sx, sy, thickness, attenuation);
+                cx = sx; cy = sy;
+            }
+            continue;
+        }
+        if (std::isspace(static_cast<unsigned char>(*p)) || *p == ',') { p++; continue; }
+
+        // Nombre d'arguments à ignorer avant le point final de la commande
+        int skip = 0;
+        bool relative = std::islower(static_cast<unsigned char>(command));
+        switch (std::toupper(static_cast<unsigned char>(command))) {
+            case 'M': case 'L': case 'T': skip = 0; break;
+            case 'H': case 'V': skip = -1; break;
+            case 'Q': case 'S': skip = 2; break;
+            case 'C': skip = 4; break;
+            case 'A': skip = 5; break;
+            default: p++; continue;
+        }
+
+        double nx = cx, ny = cy, ignored;
+        bool ok = true;
+        for (int i = 0; i < skip && ok; i++) ok = readNumber(ignored);
+        if (skip == -1) {
+            double v;
+            ok = readNumber(v);
+            if (std::toupper(static_cast<unsigned char>(command)) == 'H') nx = relative ? cx + v : v;
+            else ny = relative ? cy + v : v;
+        } else if (ok) {
+            double vx, vy;
+            ok = readNumber(vx) && readNumber(vy);
+            nx = relative ? cx + vx : vx;
+            ny = relative ? cy + vy : vy;
+        }
+        if (!ok) { p++; continue; }
+
+        if (command == 'M' || command == 'm') {
+            sx = nx; sy = ny;
+            // Les paires suivantes d'un M sont des L implicites
+            command = (command == 'M') ? 'L' : 'l';
+        } else {
+            pushSegment(out, options, cx, cy, nx, ny, thickness, attenuation);
+        }
+        cx = nx; cy = ny;
+    }
+}
+
+/////////////////////////////// Fusion ///////////////////////////////
+
+struct LineKey {
+    size_t index;
+    double theta;   // Direction dans [-tol, pi - tol)
+    double rho;     // Distance signée de la droite à l'origine
+};
+
+} // namespace
+
+std::vector<WallSegment> readSVGSegments(const std::string& filename, const FloorplanImportOptions& options) {
+    std::vector<WallSegment> segments;
+    std::ifstream file(filename);
+    if (!file) {
+        std::cerr << "Impossible d'ouvrir le fichier: " << filename << std::endl;
+        return segments;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string svg = buffer.str();
+
+    std::vector<std::string> groups; // Pile des calques (<g>) englobants
+    size_t pos = 0;
+    while ((pos = svg.find('<', pos)) != std::string::npos) {
+        size_t end = svg.find('>', pos);
+        if (end == std::string::npos) break;
+        std::string tag = svg.substr(pos, end - pos + 1);
+        pos = end + 1;
+
+        if (tag.compare(0, 3, "</g") == 0) {
+            if (!groups.empty()) groups.pop_back();
+            continue;
+        }
+
+        size_t nameEnd = tag.find_first_of(" \t\r\n/>", 1);
+        std::string name = tag.substr(1, nameEnd - 1);
+
+        if (name == "g") {
+            if (tag[tag.size() - 2] == '/') continue;
+            std::string layer = svgAttribute(tag, "inkscape:label");
+            if (layer.empty()) layer = svgAttribute(tag, "id");
+            groups.push_back(layer.empty() && !groups.empty() ? groups.back() : layer);
+            continue;
+        }
+
+        std::string layer = svgAttribute(tag, "class");
+        if (layer.empty() && !groups.empty()) layer = groups.back();
+        const double attenuation = layerAttenuation(options, layer);
+        const double thickness = svgStrokeWidth(tag, options);
+
+        if (name == "line") {
+            double x1 = std::strtod(svgAttribute(tag, "x1").c_str(), nullptr);
+            double y1 = std::strtod(svgAttribute(tag, "y1").c_str(), nullptr);
+            double x2 = std::strtod(svgAttribute(tag, "x2").c_str(), nullptr);
+            double y2 = std::strtod(svgAttribute(tag, "y2").c_str(), nullptr);
+            pushSegment(segments, options, x1, y1, x2, y2, thickness, attenuation);
+        }
+        else if (name == "polyline" || name == "polygon") {
+            std::vector<double> pts = svgNumbers(svgAttribute(tag, "points"));
+            size_t n = pts.size() / 2;
+            for (size_t i = 1; i < n; i++) {
+                pushSegment(segments, options, pts[2*i-2], pts[2*i-1], pts[2*i], pts[2*i+1], thickness, attenuation);
+            }
+            if (name == "polygon" && n > 2) {
+                pushSegment(segments, options, pts[2*n-2], pts[2*n-1], pts[0], pts[1], thickness, attenuation);
+            }
+        }
+        else if (name == "rect") {
+            double x = std::strtod(svgAttribute(tag, "x").c_str(), nullptr);
+            double y = std::strtod(svgAttribute(tag, "y").c_str(), nullptr);
+            double w = std::strtod(svgAttribute(tag, "width").c_str(), nullptr);
+            double h = std::strtod(svgAttribute(tag, "height").c_str(), nullptr);
+            pushSegment(segments, options, x, y, x + w, y, thickness, attenuation);
+            pushSegment(segments, options, x + w, y, x + w, y + h, thickness, attenuation);
+            pushSegment(segments, options, x + w, y + h, x, y + h, thickness, attenuation);
+            pushSegment(segments, options, x, y + h, x, y, thickness, attenuation);
+        }
+        else if (name == "path") {
+            svgPathSegments(svgAttribute(tag, "d"), segments, options, thickness, attenuation);
+        }
+    }
+    return segments;
+}
+
+std::vector<WallSegment> readDXFSegments(const std::string& filename, const FloorplanImportOptions& options) {
+    std::vector<WallSegment> segments;
+    std::ifstream file(filename);
+    if (!file) {
+        std::cerr << "Impossible d'ouvrir le fichier: " << filename << std::endl;
+        return segments;
+    }
+
+    // Un DXF est une suite de paires (code de groupe, valeur)
+    std::vector<std::pair<int, std::string>> pairs;
+    std::string codeLine, valueLine;
+    while (std::getline(file, codeLine) && std::getline(file, valueLine)) {
+        if (!valueLine.empty() && valueLine.back() == '\r') valueLine.pop_back();
+        size_t first = valueLine.find_first_not_of(" \t");
+        valueLine = first == std::string::npos ? "" : valueLine.substr(first);
+        pairs.emplace_back(std::atoi(codeLine.c_str()), valueLine);
+    }
+
+    // Entité courante en cours de lecture (seule la section ENTITIES est importée)
+    std::string section, entity, layer;
+    std::vector<double> xs, ys;
+    double x2 = 0, y2 = 0, width = 0;
+    bool closed = false;
+    std::string polylineLayer;
+    std::vector<double> polyXs, polyYs;
+    bool polylineClosed = false, inPolyline = false;
+
+    auto emitPolyline = [&](const std::vector<double>& px, const std::vector<double>& py, bool isClosed,
+                            const std::string& lay, double w) {
+        const double att = layerAttenuation(options, lay);
+        const double thick = w > 0 ? w * options.scale : options.thickness;
+        for (size_t i = 1; i < px.size(); i++) {
+            pushSegment(segments, options, px[i-1], py[i-1], px[i], py[i], thick, att);
+        }
+        if (isClosed && px.size() > 2) {
+            pushSegment(segments, options, px.back(), py.back(), px[0], py[0], thick, att);
+        }
+    };
+
+    auto finishEntity = [&]() {
+        if (section != "ENTITIES") return;
+        if (entity == "LINE" && !xs.empty() && !ys.empty()) {
+            const double thick = width > 0 ? width * options.scale : options.thickness;
+            pushSegment(segments, options, xs[0], ys[0], x2, y2, thick, layerAttenuation(options, layer));
+        }
+        else if (entity == "LWPOLYLINE") {
+            emitPolyline(xs, ys, closed, layer, width);
+        }
+        else if (entity == "VERTEX" && inPolyline && !xs.empty() && !ys.empty()) {
+            polyXs.push_back(xs[0]);
+            polyYs.push_back(ys[0]);
+        }
+    };
+
+    for (const auto& pr : pairs) {
+        const int code = pr.first;
+        const std::string& value = pr.second;
+
+        if (code == 0) {
+            finishEntity();
+            if (value == "POLYLINE") {
+                inPolyline = true;
+                polyXs.clear();
+                polyYs.clear();
+            } else if (value == "SEQEND" && inPolyline && section == "ENTITIES") {
+                emitPolyline(polyXs, polyYs, polylineClosed, polylineLayer, 0);
+                inPolyline = false;
+            }
+            entity = value;
+            layer.clear();
+            xs.clear();
+            ys.clear();
+            x2 = y2 = width = 0;
+            closed = false;
+            continue;
+        }
+
+        if (entity == "SECTION" && code == 2) {
+            section = value;
+            continue;
+        }
+
+        const double v = std::strtod(value.c_str(), nullptr);
+        switch (code) {
+            case 8:  layer = value; if (entity == "POLYLINE") polylineLayer = value; break;
+            case 10: xs.push_back(v); break;
+            case 20: ys.push_back(v); break;
+            case 11: x2 = v; break;
+            case 21: y2 = v; break;
+            case 43: width = v; break;
+            case 70:
+                closed = (static_cast<int>(v) & 1) != 0;
+                if (entity == "POLYLINE") polylineClosed = closed;
+                break;
+            default: break;
+        }
+    }
+    finishEntity();
+    return segments;
+}
+
+std::vector<WallSegment> simplifySegments(const std::vector<WallSegment>& segments,
+                                          const FloorplanImportOptions& options,
+                                          FloorplanImportStats& stats) {
+    const double tol = options.angleTolerance;
+
+    // Classement par matériau, direction puis position de la droite support
+    std::vector<LineKey> keys;
+    keys.reserve(segments.size());
+    for (size_t i = 0; i < segments.size(); i++) {
+        const auto& s = segments[i];
+        const double dx = s.x2 - s.x1, dy = s.y2 - s.y1;
+        if (dx*dx + dy*dy < Obstacle::EPSILON * Obstacle::EPSILON) {
+            stats.sliversDropped++;
+            continue;
+        }
+        double theta = std::atan2(dy, dx);
+        if (theta < 0) theta += M_PI;
+        if (theta >= M_PI - tol) theta -= M_PI;
+        const double rho = -std::sin(theta) * s.x1 + std::cos(theta) * s.y1;
+        keys.push_back({i, theta, rho});
+    }
+
+    auto sameMaterial = [&](const LineKey& a, const LineKey& b) {
+        return segments[a.index].thickness == segments[b.index].thickness &&
+               segments[a.index].attenuation == segments[b.index].attenuation;
+    };
+
+    std::sort(keys.begin(), keys.end(), [&](const LineKey& a, const LineKey& b) {
+        const auto& sa = segments[a.index];
+        const auto& sb = segments[b.index];
+        if (sa.thickness != sb.thickness) return sa.thickness < sb.thickness;
+        if (sa.attenuation != sb.attenuation) return sa.attenuation < sb.attenuation;
+        return a.theta < b.theta;
+    });
+
+    std::vector<WallSegment> result;
+    size_t start = 0;
+    while (start < keys.size()) {
+        // Groupe de même matériau et de même direction
+        size_t end = start + 1;
+        while (end < keys.size() && sameMaterial(keys[start], keys[end]) &&
+               keys[end].theta - keys[start].theta <= tol) {
+            end++;
+        }
+        std::sort(keys.begin() + start, keys.begin() + end,
+                  [](const LineKey& a, const LineKey& b) { return a.rho < b.rho; });
+
+        size_t lineStart = start;
+        while (lineStart < end) {
+            // Sous-groupe de segments portés par la même droite
+            size_t lineEnd = lineStart + 1;
+            while (lineEnd < end && keys[lineEnd].rho - keys[lineStart].rho <= options.collinearTolerance) {
+                lineEnd++;
+            }
+
+            // Direction de référence : exactement axée si le groupe l'est
+            double thetaSum = 0, rhoSum = 0;
+            for (size_t k = lineStart; k < lineEnd; k++) {
+                thetaSum += keys[k].theta;
+                rhoSum += keys[k].rho;
+            }
+            const size_t count = lineEnd - lineStart;
+            double theta = thetaSum / count;
+            if (std::abs(theta) <= tol) theta = 0;
+            else if (std::abs(theta - M_PI / 2) <= tol) theta = M_PI / 2;
+            const double rho = rhoSum / count;
+            const double ux = (theta == M_PI / 2) ? 0.0 : std::cos(theta);
+            const double uy = (theta == 0) ? 0.0 : std::sin(theta);
+            const double ox = -uy * rho, oy = ux * rho;  // Point de la droite le plus proche de l'origine
+
+            // Intervalles projetés sur la droite, fusionnés s'ils se touchent
+            std::vector<std::pair<double, double>> intervals;
+            intervals.reserve(count);
+            for (size_t k = lineStart; k < lineEnd; k++) {
+                const auto& s = segments[keys[k].index];
+                double t1 = s.x1 * ux + s.y1 * uy;
+                double t2 = s.x2 * ux + s.y2 * uy;
+                intervals.emplace_back(std::min(t1, t2), std::max(t1, t2));
+            }
+            std::sort(intervals.begin(), intervals.end());
+
+            const auto& model = segments[keys[lineStart].index];
+            auto flush = [&](double t1, double t2) {
+                if (t2 - t1 < options.minLength) {
+                    stats.sliversDropped++;
+                    return;
+                }
+                result.push_back({ox + t1 * ux, oy + t1 * uy, ox + t2 * ux, oy + t2 * uy,
+                                  model.thickness, model.attenuation});
+            };
+
+            double curStart = intervals[0].first, curEnd = intervals[0].second;
+            for (size_t k = 1; k < intervals.size(); k++) {
+                if (intervals[k].first <= curEnd + options.gapTolerance) {
+                    curEnd = std::max(curEnd, intervals[k].second);
+                    stats.segmentsMerged++;
+                } else {
+                    flush(curStart, curEnd);
+                    curStart = intervals[k].first;
+                    curEnd = intervals[k].second;
+                }
+            }
+            flush(curStart, curEnd);
+
+            lineStart = lineEnd;
+        }
+        start = end;
+    }
+    return result;
+}
+
+FloorplanImportStats importFloorplan(Room& room, const std::string& filename, const FloorplanImportOptions& options) {
+    FloorplanImportStats stats;
+
+    const std::string lower = toLower(filename);
+    std::vector<WallSegment> segments;
+    if (lower.size() > 4 && lower.compare(lower.size() - 4, 4, ".svg") == 0) {
+        segments = readSVGSegments(filename, options);
+    } else if (lower.size() > 4 && lower.compare(lower.size() - 4, 4, ".dxf") == 0) {
+        segments = readDXFSegments(filename, options);
+    } else {
+        std::cerr << "Format de plan non reconnu (SVG ou DXF attendu): " << filename << std::endl;
+        return stats;
+    }
+    stats.segmentsRead = static_cast<int>(segments.size());
+    if (segments.empty()) {
+        std::cerr << "Aucun segment de mur lu dans le plan: " << filename << std::endl;
+        return stats;
+    }
+
+    for (const auto& s : simplifySegments(segments, options, stats)) {
+        // Même tolérance que MurDroit pour reconnaître un mur axé
+        if (std::abs(s.x1 - s.x2) < 0.001 || std::abs(s.y1 - s.y2) < 0.001) {
+            room.addObstacle(new MurDroit(std::min(s.x1, s.x2), std::min(s.y1, s.y2),
+                                          std::max(s.x1, s.x2), std::max(s.y1, s.y2),
+                                          s.thickness, s.attenuation));
+            stats.mursDroits++;
+        } else {
+            room.addObstacle(new Mur(s.x1, s.y1, s.x2, s.y2, s.thickness, s.attenuation));
+            stats.mursObliques++;
+        }
+        stats.obstaclesAdded++;
+    }
+
+    std::cout << "Plan importe depuis " << filename << ": " << stats.segmentsRead
+              << " segments -> " << stats.obstaclesAdded << " obstacles ("
+              << stats.segmentsMerged << " fusionnes, " << stats.sliversDropped << " supprimes, "
+              << stats.mursDroits << " murs droits, " << stats.mursObliques << " murs obliques)" << std::endl;
+    return stats;
+}
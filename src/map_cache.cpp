@@ -0,0 +1,78 @@
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <thread>
+
+#include "../headers/map_cache.hpp"
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+    long processId() {
+#ifdef _WIN32
+        return _getpid();
+#else
+        return static_cast<long>(::getpid());
+#endif
+    }
+}
+
+MapCache::MapCache(const std::string& directory) : directory(directory) {
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        std::cerr << "Impossible de creer le repertoire de cache: " << directory << std::endl;
+    }
+}
+
+std::string MapCache::entryPath(const Room& room) const {
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << room.sceneHash() << ".pmap";
+    return (std::filesystem::path(directory) / name.str()).string();
+}
+
+bool MapCache::load(Room& room) const {
+    if (!room.loadFromBinary(entryPath(room), room.sceneHash())) return false;
+
+    // Une entrée sans couches par émetteur ne suffit pas si elles sont demandées
+    if (room.keepEmitterLayers && room.emitterLayers.size() != room.emitters.size()) return false;
+    return true;
+}
+
+bool MapCache::store(const Room& room) const {
+    const std::string path = entryPath(room);
+    // Propre au processus et au thread : deux écrivains de la même entrée (scènes identiques d'un
+    // lot, serveurs partageant le cache) ne mélangent jamais leurs fichiers
+    std::ostringstream temporaryName;
+    temporaryName << path << "." << processId() << "-" << std::hash<std::thread::id>()(std::this_thread::get_id()) << ".tmp";
+    const std::string temporary = temporaryName.str();
+    if (!room.exportToBinary(temporary)) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temporary, path, ec);
+    if (ec) {
+        std::remove(temporary.c_str());
+        std::cerr << "Impossible d'enregistrer l'entree de cache: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool MapCache::computeSignalMap(Room& room) const {
+    if (load(room)) {
+        std::cout << "Carte chargee depuis le cache: " << entryPath(room) << std::endl;
+        return true;
+    }
+    room.computeSignalMap();
+    store(room);
+    return false;
+}
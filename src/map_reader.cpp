@@ -0,0 +1,60 @@
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+#include "../headers/map_reader.hpp"
+
+void InMemoryMapReader::readRow(int y, int x0, int x1, double* out) {
+    std::copy(map[y].begin() + x0, map[y].begin() + x1, out);
+}
+
+void QuantizedMapReader::readRow(int y, int x0, int x1, double* out) {
+    const int16_t* row = map.data() + static_cast<size_t>(y) * width;
+    for (int x = x0; x < x1; x++) out[x - x0] = QuantizedPower::decode(row[x]);
+}
+
+bool exportMapToCSV(PowerMapReader& reader, const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file) {
+        std::cerr << "Erreur d'ouverture du fichier !" << std::endl;
+        return false;
+    }
+
+    // Écriture ligne par ligne
+    const int width = reader.mapWidth();
+    std::vector<double> row(width);
+    for (int y = 0; y < reader.mapHeight(); y++) {
+        reader.readRow(y, 0, width, row.data());
+        for (int i = 0; i < width; i++) {
+            file << row[i];
+            if (i < width - 1) file << ",";
+        }
+        file << "\n";
+    }
+    file.close();
+    std::cout << "Carte exportée vers " << filename << std::endl;
+    return static_cast<bool>(file);
+}
+
+MapComparison compareMaps(PowerMapReader& reference, PowerMapReader& candidate, double tolerance) {
+    MapComparison result;
+    const int width = std::min(reference.mapWidth(), candidate.mapWidth());
+    const int height = std::min(reference.mapHeight(), candidate.mapHeight());
+    std::vector<double> expected(width), actual(width);
+    double sum = 0.0;
+    for (int y = 0; y < height; y++) {
+        reference.readRow(y, 0, width, expected.data());
+        candidate.readRow(y, 0, width, actual.data());
+        for (int x = 0; x < width; x++) {
+            if (expected[x] == -555 || actual[x] == -555) continue;
+            const double error = std::abs(actual[x] - expected[x]);
+            result.points++;
+            if (error > tolerance) result.differing++;
+            if (error > MapComparison::FLIP_THRESHOLD) result.flipped++;
+            result.maxError = std::max(result.maxError, error);
+            sum += error;
+        }
+    }
+    if (result.points > 0) result.meanError = sum / result.points;
+    return result;
+}
@@ -148,6 +148,35 @@ bool Mur::isPointInside(double px, double py) const {
            (std::abs(proj_perp) <= pg.demi_epaisseur + EPSILON);
 }
 
+bool Mur::overlapsBox(double min_x, double min_y, double max_x, double max_y) const {
+    const auto& pg = params_geo;
+    const double center_x = (min_x + max_x) / 2, center_y = (min_y + max_y) / 2;
+    const double half_x = (max_x - min_x) / 2, half_y = (max_y - min_y) / 2;
+
+    // Cas dégénéré traité comme un cercle, comme isPointInside
+    if (pg.longueur_sq < EPSILON * EPSILON) {
+        const double dx = std::max(std::abs(pg.mid_x - center_x) - half_x, 0.0);
+        const double dy = std::max(std::abs(pg.mid_y - center_y) - half_y, 0.0);
+        return (dx*dx + dy*dy) <= (pg.demi_epaisseur * pg.demi_epaisseur) + EPSILON;
+    }
+
+    // Axes du rectangle : boîte englobante du mur
+    double wall_min_x, wall_min_y, wall_max_x, wall_max_y;
+    getExpandedBounds(wall_min_x, wall_min_y, wall_max_x, wall_max_y);
+    if (wall_max_x < min_x - EPSILON || wall_min_x > max_x + EPSILON ||
+        wall_max_y < min_y - EPSILON || wall_min_y > max_y + EPSILON) return false;
+
+    // Axes du mur : centre du rectangle projeté, demi-étendue du rectangle sur chaque axe
+    const double dx = center_x - pg.mid_x;
+    const double dy = center_y - pg.mid_y;
+    const double proj_axe = dx * pg.dir_unit_x + dy * pg.dir_unit_y;
+    const double proj_perp = dx * pg.perp_dir_x + dy * pg.perp_dir_y;
+    const double reach_axe = half_x * std::abs(pg.dir_unit_x) + half_y * std::abs(pg.dir_unit_y);
+    const double reach_perp = half_x * std::abs(pg.perp_dir_x) + half_y * std::abs(pg.perp_dir_y);
+    return (std::abs(proj_axe) <= pg.demi_longueur + reach_axe + EPSILON) &&
+           (std::abs(proj_perp) <= pg.demi_epaisseur + reach_perp + EPSILON);
+}
+
 bool Mur::segmentIntersectsRectangle(double x0, double y0, double x1, double y1, double rect_x1, double rect_y1, double rect_x2, double rect_y2) const {
     double t_min = 0.0;
     double t_max = 1.0;
@@ -176,8 +205,26 @@ bool Mur::segmentIntersectsRectangle(double x0, double y0, double x1, double y1,
 }
 
 bool Mur::isBlocking(double x, double y, double emitter_x, double emitter_y) const {
+    PreparedObstacle prepared;
+    Mur::prepare(emitter_x, emitter_y, prepared);
+    return Mur::isBlocking(x, y, prepared);
+}
+
+void Mur::prepare(double emitter_x, double emitter_y, PreparedObstacle& prepared) const {
+    Obstacle::prepare(emitter_x, emitter_y, prepared);
+    const auto& pg = params_geo;
+    if (pg.longueur_sq < EPSILON * EPSILON) return;
+
+    // Projections de l'émetteur sur les axes du mur
+    const double local_em_x = emitter_x - pg.mid_x;
+    const double local_em_y = emitter_y - pg.mid_y;
+    prepared.terms[0] = local_em_x * pg.dir_unit_x + local_em_y * pg.dir_unit_y;
+    prepared.terms[1] = local_em_x * pg.perp_dir_x + local_em_y * pg.perp_dir_y;
+}
+
+bool Mur::isBlocking(double x, double y, const PreparedObstacle& prepared) const {
     // Vérification rapide: si l'émetteur ou le point est à l'intérieur de l'obstacle
-    if (isPointInside(x, y) || isPointInside(emitter_x, emitter_y)) {
+    if (prepared.emitterInside || isPointInside(x, y)) {
         return true;
     }
 
@@ -185,22 +232,99 @@ bool Mur::isBlocking(double x, double y, double emitter_x, double emitter_y) con
     if (pg.longueur_sq < EPSILON * EPSILON) return false;
 
     // Conversion vers le repère local
-    const double local_em_x = emitter_x - pg.mid_x;
-    const double local_em_y = emitter_y - pg.mid_y;
     const double local_pt_x = x - pg.mid_x;
     const double local_pt_y = y - pg.mid_y;
 
     // Projections sur les axes
-    const double proj_em_axe = local_em_x * pg.dir_unit_x + local_em_y * pg.dir_unit_y;
-    const double proj_em_perp = local_em_x * pg.perp_dir_x + local_em_y * pg.perp_dir_y;
     const double proj_pt_axe = local_pt_x * pg.dir_unit_x + local_pt_y * pg.dir_unit_y;
     const double proj_pt_perp = local_pt_x * pg.perp_dir_x + local_pt_y * pg.perp_dir_y;
 
     // Application du théorème de l'axe séparateur
     return satTest(
-        proj_em_axe, proj_em_perp,   // Projections émetteur
-        proj_pt_axe, proj_pt_perp,   // Projections récepteur
+        prepared.terms[0], prepared.terms[1], // Projections émetteur (préparées)
+        proj_pt_axe, proj_pt_perp,            // Projections récepteur
         -pg.demi_longueur, pg.demi_longueur,  // Plage axe principal
         -pg.demi_epaisseur, pg.demi_epaisseur // Plage axe perpendiculaire
     );
-}
\ No newline at end of file
+}
+
+void Mur::blockingMask(const double* xs, const double* ys, const PreparedObstacle& prepared, double* mask) const {
+    packetMask(xs, ys, prepared, mask);
+}
+
+void Mur::blockingMask(const float* xs, const float* ys, const PreparedObstacle& prepared, float* mask) const {
+    packetMask(xs, ys, prepared, mask);
+}
+
+template <typename Scalar>
+void Mur::packetMask(const Scalar* xs, const Scalar* ys, const PreparedObstacle& prepared, Scalar* mask) const {
+    // Émetteur dans l'obstacle : tous les rayons sont bloqués
+    if (prepared.emitterInside) {
+        std::fill(mask, mask + PACKET_SIZE, Scalar(1));
+        return;
+    }
+    const auto& pg = params_geo;
+    if (pg.longueur_sq < EPSILON * EPSILON) {
+        for (int i = 0; i < PACKET_SIZE; i++) mask[i] = isPointInside(xs[i], ys[i]) ? Scalar(1) : Scalar(0);
+        return;
+    }
+
+    // Géométrie du mur et projections de l'émetteur (préparées), dans le type des calculs
+    const Scalar mid_x = static_cast<Scalar>(pg.mid_x), mid_y = static_cast<Scalar>(pg.mid_y);
+    const Scalar dir_x = static_cast<Scalar>(pg.dir_unit_x), dir_y = static_cast<Scalar>(pg.dir_unit_y);
+    const Scalar perp_x = static_cast<Scalar>(pg.perp_dir_x), perp_y = static_cast<Scalar>(pg.perp_dir_y);
+    const Scalar e_axe = static_cast<Scalar>(prepared.terms[0]);
+    const Scalar e_perp = static_cast<Scalar>(prepared.terms[1]);
+    const Scalar min_a = static_cast<Scalar>(-pg.demi_longueur), max_a = static_cast<Scalar>(pg.demi_longueur);
+    const Scalar min_p = static_cast<Scalar>(-pg.demi_epaisseur), max_p = static_cast<Scalar>(pg.demi_epaisseur);
+    const Scalar inside_a = static_cast<Scalar>(pg.demi_longueur + EPSILON);
+    const Scalar inside_p = static_cast<Scalar>(pg.demi_epaisseur + EPSILON);
+    const Scalar below_a = static_cast<Scalar>(-pg.demi_longueur - EPSILON), above_a = static_cast<Scalar>(pg.demi_longueur + EPSILON);
+    const Scalar below_p = static_cast<Scalar>(-pg.demi_epaisseur - EPSILON), above_p = static_cast<Scalar>(pg.demi_epaisseur + EPSILON);
+    const Scalar epsilon = static_cast<Scalar>(EPSILON);
+
+    // Copies locales : sans recouvrement possible avec mask, la boucle est vectorisée dès -O2
+    Scalar px[PACKET_SIZE], py[PACKET_SIZE], out[PACKET_SIZE];
+    std::copy(xs, xs + PACKET_SIZE, px);
+    std::copy(ys, ys + PACKET_SIZE, py);
+
+    // Mêmes opérations que isPointInside puis satTest, les sorties anticipées devenant des sélections
+    // (& et | sans court-circuit, min / max écrits en comparaisons : pas de branche dans la boucle)
+    for (int i = 0; i < PACKET_SIZE; i++) {
+        const Scalar dx = px[i] - mid_x;
+        const Scalar dy = py[i] - mid_y;
+        const Scalar p_axe = dx * dir_x + dy * dir_y;
+        const Scalar p_perp = dx * perp_x + dy * perp_y;
+        const bool inside = (std::abs(p_axe) <= inside_a) & (std::abs(p_perp) <= inside_p);
+
+        // max(e, p) < borne : les deux sous la borne ; min(e, p) > borne : les deux au-dessus
+        const bool excluded = ((e_axe < below_a) & (p_axe < below_a)) | ((e_axe > above_a) & (p_axe > above_a)) |
+                              ((e_perp < below_p) & (p_perp < below_p)) | ((e_perp > above_p) & (p_perp > above_p));
+
+        const Scalar delta_axe = p_axe - e_axe;
+        const Scalar delta_perp = p_perp - e_perp;
+        Scalar t_enter = 0, t_exit = 1;
+
+        const Scalar a1 = (min_a - e_axe) / delta_axe;
+        const Scalar a2 = (max_a - e_axe) / delta_axe;
+        const Scalar a_near = a1 < a2 ? a1 : a2, a_far = a1 < a2 ? a2 : a1;
+        const bool useAxe = std::abs(delta_axe) > epsilon;
+        t_enter = (useAxe & (a_near > t_enter)) ? a_near : t_enter;
+        t_exit = (useAxe & (a_far < t_exit)) ? a_far : t_exit;
+
+        const Scalar p1 = (min_p - e_perp) / delta_perp;
+        const Scalar p2 = (max_p - e_perp) / delta_perp;
+        const Scalar p_near = p1 < p2 ? p1 : p2, p_far = p1 < p2 ? p2 : p1;
+        const bool usePerp = std::abs(delta_perp) > epsilon;
+        t_enter = (usePerp & (p_near > t_enter)) ? p_near : t_enter;
+        t_exit = (usePerp & (p_far < t_exit)) ? p_far : t_exit;
+
+        const bool crossing = !excluded & (t_enter <= t_exit) & (t_exit >= 0) & (t_enter <= 1);
+        out[i] = (inside | crossing) ? Scalar(1) : Scalar(0);
+    }
+    std::copy(out, out + PACKET_SIZE, mask);
+}
+
+void Mur::describe(std::ostream& os) const {
+    os << "MUR " << x1 << " " << y1 << " " << x2 << " " << y2 << " " << thickness << " " << attenuation;
+}
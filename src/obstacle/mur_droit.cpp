@@ -1,7 +1,6 @@
 #include <cmath>
 #include <algorithm>
 #include <stdexcept>
-#include <iostream>
 #include <ostream>
 
 #include "../headers/obstacle.hpp"
@@ -9,114 +8,226 @@
 
 MurDroit::MurDroit(double x1, double y1, double x2, double y2, double thickness, double attenuation)
 : Mur(x1, y1, x2, y2, thickness, attenuation) {
-    // Normaliser les coordonnées pour que (x1,y1) soit toujours le coin inférieur gauche
-    if (x1 > x2) std::swap(x1, x2);
-    if (y1 > y2) std::swap(y1, y2);
+    // Orientation décidée une fois pour toutes ; étendue normalisée pour que from <= to
+    if (std::abs(x1 - x2) < 0.001) {
+        orientation = VERTICAL;
+        position = x1;
+        from = std::min(y1, y2);
+        to = std::max(y1, y2);
+    }
+    else if (std::abs(y1 - y2) < 0.001) {
+        orientation = HORIZONTAL;
+        position = y1;
+        from = std::min(x1, x2);
+        to = std::max(x1, x2);
+    }
+    else {
+        orientation = OBLIQUE;
+        position = from = to = 0.0;
+    }
 }
 
 bool MurDroit::isPointInside(double px, double py) const {
-    // Pour un mur vertical
-    if (std::abs(x1 - x2) < 0.001) {
-        return (px >= (x1 - thickness/2) && px <= (x1 + thickness/2) &&
-                py >= y1 && py <= y2);
+    switch (orientation) {
+        case VERTICAL:
+            return (px >= (position - thickness/2) && px <= (position + thickness/2) &&
+                    py >= from && py <= to);
+        case HORIZONTAL:
+            return (py >= (position - thickness/2) && py <= (position + thickness/2) &&
+                    px >= from && px <= to);
+        default:
+            return Mur::isPointInside(px, py);
     }
-    // Pour un mur horizontal
-    else if (std::abs(y1 - y2) < 0.001) {
-        return (py >= (y1 - thickness/2) && py <= (y1 + thickness/2) &&
-                px >= x1 && px <= x2);
+}
+
+bool MurDroit::overlapsBox(double min_x, double min_y, double max_x, double max_y) const {
+    switch (orientation) {
+        case VERTICAL:
+            return (max_x >= (position - thickness/2) && min_x <= (position + thickness/2) &&
+                    max_y >= from && min_y <= to);
+        case HORIZONTAL:
+            return (max_y >= (position - thickness/2) && min_y <= (position + thickness/2) &&
+                    max_x >= from && min_x <= to);
+        default:
+            return Mur::overlapsBox(min_x, min_y, max_x, max_y);
     }
-    std::cout << "Erreur : Mur ni vertical ni horizontal" << std::endl;
-    return false;
 }
 
 bool MurDroit::isBlocking(double x, double y, double emitter_x, double emitter_y) const {
+    PreparedObstacle prepared;
+    MurDroit::prepare(emitter_x, emitter_y, prepared);
+    return MurDroit::isBlocking(x, y, prepared);
+}
+
+void MurDroit::prepare(double emitter_x, double emitter_y, PreparedObstacle& prepared) const {
+    if (orientation == OBLIQUE) {
+        Mur::prepare(emitter_x, emitter_y, prepared);
+        return;
+    }
+    Obstacle::prepare(emitter_x, emitter_y, prepared);
+
+    // Écarts des faces à l'émetteur en travers du mur, numérateurs des t_left / t_right de isBlocking
+    const double across = orientation == VERTICAL ? emitter_x : emitter_y;
+    prepared.terms[0] = (position - thickness / 2) - across;
+    prepared.terms[1] = (position + thickness / 2) - across;
+}
+
+bool MurDroit::isBlocking(double x, double y, const PreparedObstacle& prepared) const {
+    if (orientation == OBLIQUE) return Mur::isBlocking(x, y, prepared);
+
     // Vérification rapide: si l'émetteur ou le point est à l'intérieur de l'obstacle
-    if (isPointInside(x, y) || isPointInside(emitter_x, emitter_y)) return true;
-    // else return false;
-    
+    if (prepared.emitterInside || isPointInside(x, y)) return true;
+
+    if (orientation == VERTICAL) return isBlockingVertical(x, y, prepared.emitter_x, prepared.emitter_y);
+    return isBlockingHorizontal(x, y, prepared.emitter_x, prepared.emitter_y);
+}
 
-    // Cas vertical optimisé (avec épaisseur)
-    if (std::abs(x1 - x2) < EPSILON) {
+// Cas vertical optimisé (avec épaisseur)
+bool MurDroit::isBlockingVertical(double x, double y, double emitter_x, double emitter_y) const {
+    double left = position - thickness / 2;
+    double right = position + thickness / 2;
 
-        double wall_x = x1;
-        double left = wall_x - thickness / 2;
-        double right = wall_x + thickness / 2;
+    // Si l'émetteur et le point cible sont du même côté du mur, pas d'intersection
+    if ((emitter_x < left && x < left) || (emitter_x > right && x > right)) {
+        return false;
+    }
 
-        // Si l'émetteur et le point cible sont du même côté du mur, pas d'intersection
-        if ((emitter_x < left && x < left) || (emitter_x > right && x > right)) {
-            return false;
+    // Si le mur est entre l'émetteur et le point cible
+    if ((emitter_x <= left && x >= left) || (emitter_x >= right && x <= right)) {
+        // Calcul du point d'intersection
+        double dx = x - emitter_x;
+        if (std::abs(dx) < EPSILON) {
+            // Ligne verticale - vérifier si elle traverse le mur
+            return (std::min(y, emitter_y) <= to && std::max(y, emitter_y) >= from);
         }
 
-        // Si le mur est entre l'émetteur et le point cible
-        if ((emitter_x <= left && x >= left) || (emitter_x >= right && x <= right)) {
-            // Calcul du point d'intersection
-            double dx = x - emitter_x;
-            if (std::abs(dx) < EPSILON) {
-                // Ligne verticale - vérifier si elle traverse le mur
-                return (std::min(y, emitter_y) <= y2 && std::max(y, emitter_y) >= y1);
-            }
+        double slope = (y - emitter_y) / dx;
+        double b = emitter_y - slope * emitter_x;
 
-            double slope = (y - emitter_y) / dx;
-            double b = emitter_y - slope * emitter_x;
+        // Calcul des points d'intersection avec les deux faces du mur
+        double t_left = (left - emitter_x) / dx;
+        double y_left = slope * left + b;
+        bool valid_left = (t_left >= 0 && t_left <= 1) && 
+                        (y_left >= from - EPSILON && y_left <= to + EPSILON);
 
-            // Calcul des points d'intersection avec les deux faces du mur
-            double t_left = (left - emitter_x) / dx;
-            double y_left = slope * left + b;
-            bool valid_left = (t_left >= 0 && t_left <= 1) && 
-                            (y_left >= y1 - EPSILON && y_left <= y2 + EPSILON);
+        double t_right = (right - emitter_x) / dx;
+        double y_right = slope * right + b;
+        bool valid_right = (t_right >= 0 && t_right <= 1) && 
+                        (y_right >= from - EPSILON && y_right <= to + EPSILON);
 
-            double t_right = (right - emitter_x) / dx;
-            double y_right = slope * right + b;
-            bool valid_right = (t_right >= 0 && t_right <= 1) && 
-                            (y_right >= y1 - EPSILON && y_right <= y2 + EPSILON);
+        return valid_left || valid_right;
+    }
 
+    return false;
+}
 
-            return valid_left || valid_right;
-        }
+// Cas horizontal optimisé (avec épaisseur)
+bool MurDroit::isBlockingHorizontal(double x, double y, double emitter_x, double emitter_y) const {
+    double bottom = position - thickness / 2;
+    double top = position + thickness / 2;
 
+    // Si l'émetteur et le point cible sont du même côté du mur, pas d'intersection
+    if ((emitter_y < bottom && y < bottom) || (emitter_y > top && y > top)) {
         return false;
     }
 
-    
-    // Cas horizontal optimisé (avec épaisseur)
-    if (std::abs(y1 - y2) < EPSILON) {
+    // Si le mur est entre l'émetteur et le point cible
+    if ((emitter_y <= bottom && y >= bottom) || (emitter_y >= top && y <= top)) {
+        // Calcul du point d'intersection
+        double dy = y - emitter_y;
+        if (std::abs(dy) < EPSILON) {
+            // Ligne horizontale - vérifier si elle traverse le mur
+            return (std::min(x, emitter_x) <= to && std::max(x, emitter_x) >= from);
+        }
+
+        double slope = (x - emitter_x) / dy;
+        double b = emitter_x - slope * emitter_y;
 
-        double wall_y = y1;
-        double bottom = wall_y - thickness / 2;
-        double top = wall_y + thickness / 2;
+        // Calcul des points d'intersection avec les deux faces du mur
+        double t_bottom = (bottom - emitter_y) / dy;
+        double x_bottom = slope * bottom + b;
+        bool valid_bottom = (t_bottom >= 0 && t_bottom <= 1) && 
+                        (x_bottom >= from - EPSILON && x_bottom <= to + EPSILON);
 
-        // Si l'émetteur et le point cible sont du même côté du mur, pas d'intersection
-        if ((emitter_y < bottom && y < bottom) || (emitter_y > top && y > top)) {
-            return false;
-        }
+        double t_top = (top - emitter_y) / dy;
+        double x_top = slope * top + b;
+        bool valid_top = (t_top >= 0 && t_top <= 1) && 
+                        (x_top >= from - EPSILON && x_top <= to + EPSILON);
 
-        // Si le mur est entre l'émetteur et le point cible
-        if ((emitter_y <= bottom && y >= bottom) || (emitter_y >= top && y <= top)) {
-            // Calcul du point d'intersection
-            double dy = y - emitter_y;
-            if (std::abs(dy) < EPSILON) {
-                // Ligne horizontale - vérifier si elle traverse le mur
-                return (std::min(x, emitter_x) <= x2 && std::max(x, emitter_x) >= x1);
-            }
-
-            double slope = (x - emitter_x) / dy;
-            double b = emitter_x - slope * emitter_y;
-
-            // Calcul des points d'intersection avec les deux faces du mur
-            double t_bottom = (bottom - emitter_y) / dy;
-            double x_bottom = slope * bottom + b;
-            bool valid_bottom = (t_bottom >= 0 && t_bottom <= 1) && 
-                            (x_bottom >= x1 - EPSILON && x_bottom <= x2 + EPSILON);
-
-            double t_top = (top - emitter_y) / dy;
-            double x_top = slope * top + b;
-            bool valid_top = (t_top >= 0 && t_top <= 1) && 
-                            (x_top >= x1 - EPSILON && x_top <= x2 + EPSILON);
-
-            return valid_bottom || valid_top;
-        }
+        return valid_bottom || valid_top;
     }
-    
+
     return false;
+}
 
-} 
\ No newline at end of file
+void MurDroit::blockingMask(const double* xs, const double* ys, const PreparedObstacle& prepared, double* mask) const {
+    if (orientation == OBLIQUE) Mur::blockingMask(xs, ys, prepared, mask);
+    else packetMask(xs, ys, prepared, mask);
+}
+
+void MurDroit::blockingMask(const float* xs, const float* ys, const PreparedObstacle& prepared, float* mask) const {
+    if (orientation == OBLIQUE) Mur::blockingMask(xs, ys, prepared, mask);
+    else packetMask(xs, ys, prepared, mask);
+}
+
+template <typename Scalar>
+void MurDroit::packetMask(const Scalar* xs, const Scalar* ys, const PreparedObstacle& prepared, Scalar* mask) const {
+    // Émetteur dans l'obstacle : tous les rayons sont bloqués
+    if (prepared.emitterInside) {
+        std::fill(mask, mask + PACKET_SIZE, Scalar(1));
+        return;
+    }
+
+    // Repère du mur : u en travers (x d'un mur vertical, y d'un mur horizontal), v le long.
+    // isBlockingVertical et isBlockingHorizontal sont le même test dans ce repère
+    const bool vertical = orientation == VERTICAL;
+    const Scalar* us = vertical ? xs : ys;
+    const Scalar* vs = vertical ? ys : xs;
+    const Scalar e_u = static_cast<Scalar>(vertical ? prepared.emitter_x : prepared.emitter_y);
+    const Scalar e_v = static_cast<Scalar>(vertical ? prepared.emitter_y : prepared.emitter_x);
+    const Scalar low = static_cast<Scalar>(position - thickness / 2), high = static_cast<Scalar>(position + thickness / 2);
+    const Scalar lo = static_cast<Scalar>(from), hi = static_cast<Scalar>(to);
+    const Scalar lo_tol = static_cast<Scalar>(from - EPSILON), hi_tol = static_cast<Scalar>(to + EPSILON);
+    const Scalar to_low = static_cast<Scalar>(prepared.terms[0]), to_high = static_cast<Scalar>(prepared.terms[1]);
+    const Scalar epsilon = static_cast<Scalar>(EPSILON);
+
+    // Côté de l'émetteur par rapport aux faces, lu sur les écarts préparés (a - b a le signe de a - b)
+    const bool e_below = prepared.terms[0] > 0, e_at_or_below = prepared.terms[0] >= 0;
+    const bool e_above = prepared.terms[1] < 0, e_at_or_above = prepared.terms[1] <= 0;
+    const bool e_v_below_to = e_v <= hi, e_v_above_from = e_v >= lo;
+
+    // Copies locales : sans recouvrement possible avec mask, la boucle est vectorisée dès -O2
+    Scalar u[PACKET_SIZE], v[PACKET_SIZE], out[PACKET_SIZE];
+    std::copy(us, us + PACKET_SIZE, u);
+    std::copy(vs, vs + PACKET_SIZE, v);
+
+    // Mêmes opérations que isPointInside puis isBlockingVertical, les sorties anticipées devenant
+    // des sélections (& et | sans court-circuit : pas de branche dans la boucle)
+    for (int i = 0; i < PACKET_SIZE; i++) {
+        const bool inside = (u[i] >= low) & (u[i] <= high) & (v[i] >= lo) & (v[i] <= hi);
+        const bool sameSide = (e_below & (u[i] < low)) | (e_above & (u[i] > high));
+        const bool between = (e_at_or_below & (u[i] >= low)) | (e_at_or_above & (u[i] <= high));
+
+        // Rayon perpendiculaire au mur : il le traverse si son étendue chevauche celle du mur
+        // (min(v, e_v) <= hi et max(v, e_v) >= lo, sans std::min / std::max qui se compilent en branches)
+        const Scalar du = u[i] - e_u;
+        const bool along = ((v[i] <= hi) | e_v_below_to) & ((v[i] >= lo) | e_v_above_from);
+
+        // Sinon, intersections avec les deux faces
+        const Scalar slope = (v[i] - e_v) / du;
+        const Scalar b = e_v - slope * e_u;
+        const Scalar t_low = to_low / du, v_low = slope * low + b;
+        const Scalar t_high = to_high / du, v_high = slope * high + b;
+        const bool valid_low = (t_low >= 0) & (t_low <= 1) & (v_low >= lo_tol) & (v_low <= hi_tol);
+        const bool valid_high = (t_high >= 0) & (t_high <= 1) & (v_high >= lo_tol) & (v_high <= hi_tol);
+
+        const bool perpendicular = std::abs(du) < epsilon;
+        const bool crossing = (perpendicular & along) | ((!perpendicular) & (valid_low | valid_high));
+        out[i] = (inside | (!sameSide & between & crossing)) ? Scalar(1) : Scalar(0);
+    }
+    std::copy(out, out + PACKET_SIZE, mask);
+}
+
+void MurDroit::describe(std::ostream& os) const {
+    os << "MURDROIT " << x1 << " " << y1 << " " << x2 << " " << y2 << " " << thickness << " " << attenuation;
+}
@@ -11,3 +11,22 @@ Obstacle::Obstacle(double attenuation) : attenuation(attenuation) {}
 
 // Obstacle::~Obstacle() {};
 
+
+void Obstacle::prepare(double emitter_x, double emitter_y, PreparedObstacle& prepared) const {
+    prepared.obstacle = this;
+    prepared.emitter_x = emitter_x;
+    prepared.emitter_y = emitter_y;
+    prepared.emitterInside = isPointInside(emitter_x, emitter_y);
+}
+
+bool Obstacle::isBlocking(double x, double y, const PreparedObstacle& prepared) const {
+    return isBlocking(x, y, prepared.emitter_x, prepared.emitter_y);
+}
+
+void Obstacle::blockingMask(const double* xs, const double* ys, const PreparedObstacle& prepared, double* mask) const {
+    for (int i = 0; i < PACKET_SIZE; i++) mask[i] = isBlocking(xs[i], ys[i], prepared) ? 1.0 : 0.0;
+}
+
+void Obstacle::blockingMask(const float* xs, const float* ys, const PreparedObstacle& prepared, float* mask) const {
+    for (int i = 0; i < PACKET_SIZE; i++) mask[i] = isBlocking(xs[i], ys[i], prepared) ? 1.0f : 0.0f;
+}
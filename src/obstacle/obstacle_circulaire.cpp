@@ -29,20 +29,41 @@ void obstacleCirculaire::getExpandedBounds(double& min_x, double& min_y, double&
     max_y = cy + radius;
 }
 
+bool obstacleCirculaire::overlapsBox(double min_x, double min_y, double max_x, double max_y) const {
+    const double dx = cx - std::clamp(cx, min_x, max_x);
+    const double dy = cy - std::clamp(cy, min_y, max_y);
+    return (dx*dx + dy*dy) <= (radius * radius) + EPSILON;
+}
+
 bool obstacleCirculaire::isBlocking(double x, double y, double emitter_x, double emitter_y) const {
+    PreparedObstacle prepared;
+    obstacleCirculaire::prepare(emitter_x, emitter_y, prepared);
+    return obstacleCirculaire::isBlocking(x, y, prepared);
+}
+
+void obstacleCirculaire::prepare(double emitter_x, double emitter_y, PreparedObstacle& prepared) const {
+    Obstacle::prepare(emitter_x, emitter_y, prepared);
+    const double fx = emitter_x - cx;
+    const double fy = emitter_y - cy;
+    prepared.terms[0] = fx;
+    prepared.terms[1] = fy;
+    prepared.terms[2] = fx * fx + fy * fy - radius * radius;
+}
+
+bool obstacleCirculaire::isBlocking(double x, double y, const PreparedObstacle& prepared) const {
     // Vérification rapide: si l'émetteur ou le point est à l'intérieur de l'obstacle
-    if (isPointInside(x, y) || isPointInside(emitter_x, emitter_y)) {
+    if (prepared.emitterInside || isPointInside(x, y)) {
         return true;
     }
 
-    double dx = x - emitter_x;
-    double dy = y - emitter_y;
-    double fx = emitter_x - cx;
-    double fy = emitter_y - cy;
+    double dx = x - prepared.emitter_x;
+    double dy = y - prepared.emitter_y;
+    const double fx = prepared.terms[0];
+    const double fy = prepared.terms[1];
 
     double a = dx * dx + dy * dy;
     double b = 2 * (fx * dx + fy * dy);
-    double c = fx * fx + fy * fy - radius * radius;
+    double c = prepared.terms[2];
 
     double discriminant = b * b - 4 * a * c;
     if (discriminant < 0) return false; // Pas d'intersection
@@ -51,4 +72,59 @@ bool obstacleCirculaire::isBlocking(double x, double y, double emitter_x, double
     double t2 = (-b + std::sqrt(discriminant)) / (2 * a);
 
     return (t1 >= 0 && t1 <= 1) || (t2 >= 0 && t2 <= 1);
-}
\ No newline at end of file
+}
+
+void obstacleCirculaire::blockingMask(const double* xs, const double* ys, const PreparedObstacle& prepared, double* mask) const {
+    packetMask(xs, ys, prepared, mask);
+}
+
+void obstacleCirculaire::blockingMask(const float* xs, const float* ys, const PreparedObstacle& prepared, float* mask) const {
+    packetMask(xs, ys, prepared, mask);
+}
+
+template <typename Scalar>
+void obstacleCirculaire::packetMask(const Scalar* xs, const Scalar* ys, const PreparedObstacle& prepared, Scalar* mask) const {
+    // Émetteur dans l'obstacle : tous les rayons sont bloqués
+    if (prepared.emitterInside) {
+        std::fill(mask, mask + PACKET_SIZE, Scalar(1));
+        return;
+    }
+
+    // Cercle et termes de l'émetteur (préparés), dans le type des calculs
+    const Scalar center_x = static_cast<Scalar>(cx), center_y = static_cast<Scalar>(cy);
+    const Scalar insideLimit = static_cast<Scalar>((radius * radius) + EPSILON);
+    const Scalar emitter_x = static_cast<Scalar>(prepared.emitter_x);
+    const Scalar emitter_y = static_cast<Scalar>(prepared.emitter_y);
+    const Scalar fx = static_cast<Scalar>(prepared.terms[0]);
+    const Scalar fy = static_cast<Scalar>(prepared.terms[1]);
+    const Scalar c = static_cast<Scalar>(prepared.terms[2]);
+
+    // Copies locales : sans recouvrement possible avec mask, la boucle est vectorisée dès -O2
+    Scalar qx[PACKET_SIZE], qy[PACKET_SIZE], out[PACKET_SIZE];
+    std::copy(xs, xs + PACKET_SIZE, qx);
+    std::copy(ys, ys + PACKET_SIZE, qy);
+
+    // Mêmes opérations que isBlocking ; un discriminant négatif donne un rayon non bloqué
+    for (int i = 0; i < PACKET_SIZE; i++) {
+        const Scalar px = qx[i] - center_x;
+        const Scalar py = qy[i] - center_y;
+        const bool inside = (px * px + py * py) <= insideLimit;
+
+        const Scalar dx = qx[i] - emitter_x;
+        const Scalar dy = qy[i] - emitter_y;
+        const Scalar a = dx * dx + dy * dy;
+        const Scalar b = 2 * (fx * dx + fy * dy);
+        const Scalar discriminant = b * b - 4 * a * c;
+        const Scalar root = std::sqrt(discriminant < 0 ? Scalar(0) : discriminant);
+        const Scalar t1 = (-b - root) / (2 * a);
+        const Scalar t2 = (-b + root) / (2 * a);
+
+        const bool crossing = (discriminant >= 0) & (((t1 >= 0) & (t1 <= 1)) | ((t2 >= 0) & (t2 <= 1)));
+        out[i] = (inside | crossing) ? Scalar(1) : Scalar(0);
+    }
+    std::copy(out, out + PACKET_SIZE, mask);
+}
+
+void obstacleCirculaire::describe(std::ostream& os) const {
+    os << "CERCLE " << cx << " " << cy << " " << radius << " " << attenuation;
+}
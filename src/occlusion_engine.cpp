@@ -0,0 +1,69 @@
+#include <algorithm>
+#include <cmath>
+
+#include "../headers/occlusion_engine.hpp"
+#include "../headers/obstacle.hpp"
+
+namespace {
+
+const double TWO_PI = 2.0 * M_PI;
+
+// Angle ramené dans [-pi, pi)
+double wrapAngle(double a) {
+    return a - TWO_PI * std::floor((a + M_PI) / TWO_PI);
+}
+
+} // namespace
+
+std::vector<ObstacleSector> obstacleSectors(const std::vector<const Obstacle*>& obstacles,
+                                            double emitter_x, double emitter_y, int directions) {
+    const double step = TWO_PI / directions;
+    std::vector<ObstacleSector> sectors(obstacles.size());
+    for (size_t k = 0; k < obstacles.size(); k++) {
+        ObstacleSector& s = sectors[k];
+        obstacles[k]->getExpandedBounds(s.min_x, s.min_y, s.max_x, s.max_y);
+        s.min_x -= 1.0; s.min_y -= 1.0; s.max_x += 1.0; s.max_y += 1.0;
+
+        const double nx = std::max(0.0, std::max(s.min_x - emitter_x, emitter_x - s.max_x));
+        const double ny = std::max(0.0, std::max(s.min_y - emitter_y, emitter_y - s.max_y));
+        s.nearRadius = std::hypot(nx, ny);
+        s.farRadius = std::hypot(std::max(std::abs(s.min_x - emitter_x), std::abs(s.max_x - emitter_x)),
+                                 std::max(std::abs(s.min_y - emitter_y), std::abs(s.max_y - emitter_y)));
+
+        if (s.nearRadius == 0.0) {
+            s.first = 0;
+            s.count = directions; // Émetteur dans la boîte : tout le tour
+            continue;
+        }
+        // Émetteur hors de la boîte : secteur de moins d'un demi-tour autour de la direction du centre
+        const double center = std::atan2((s.min_y + s.max_y) / 2 - emitter_y, (s.min_x + s.max_x) / 2 - emitter_x);
+        double lo = 0.0, hi = 0.0;
+        for (double cx : {s.min_x, s.max_x}) {
+            for (double cy : {s.min_y, s.max_y}) {
+                const double d = wrapAngle(std::atan2(cy - emitter_y, cx - emitter_x) - center);
+                lo = std::min(lo, d);
+                hi = std::max(hi, d);
+            }
+        }
+        s.first = static_cast<int>(std::floor((center + lo) / step)) - 1;
+        s.count = std::min(directions, static_cast<int>(std::ceil((center + hi) / step)) + 1 - s.first + 1);
+    }
+    return sectors;
+}
+
+void sectorCandidates(const std::vector<ObstacleSector>& sectors, int directions,
+                      std::vector<uint32_t>& start, std::vector<uint32_t>& candidates) {
+    auto direction = [&](long i) { return static_cast<int>(((i % directions) + directions) % directions); };
+    start.assign(directions + 1, 0);
+    for (const ObstacleSector& s : sectors) {
+        for (int j = 0; j < s.count; j++) start[direction(static_cast<long>(s.first) + j) + 1]++;
+    }
+    for (int i = 0; i < directions; i++) start[i + 1] += start[i];
+    candidates.resize(start[directions]);
+    std::vector<uint32_t> fill(start.begin(), start.end() - 1);
+    for (size_t k = 0; k < sectors.size(); k++) {
+        for (int j = 0; j < sectors[k].count; j++) {
+            candidates[fill[direction(static_cast<long>(sectors[k].first) + j)]++] = static_cast<uint32_t>(k);
+        }
+    }
+}
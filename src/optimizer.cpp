@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+
+#include "../headers/optimizer.hpp"
+#include "../headers/parallel.hpp"
+
+namespace {
+
+// Ensemble de points de la grille grossière, un bit par point
+typedef std::vector<uint64_t> PointSet;
+
+int countPoints(const PointSet& set) {
+    int count = 0;
+    for (uint64_t word : set) count += __builtin_popcountll(word);
+    return count;
+}
+
+int countUnion(const PointSet& a, const PointSet& b) {
+    int count = 0;
+    for (size_t i = 0; i < a.size(); i++) count += __builtin_popcountll(a[i] | b[i]);
+    return count;
+}
+
+void addPoints(PointSet& into, const PointSet& from) {
+    for (size_t i = 0; i < into.size(); i++) into[i] |= from[i];
+}
+
+struct Candidate {
+    int x, y;       // Position dans la grille complète
+    int gx, gy;     // Position dans la grille des candidats
+};
+
+} // namespace
+
+PlacementResult optimizePlacement(const Room& room, const PlacementOptions& options) {
+    const auto start = std::chrono::steady_clock::now();
+    PlacementResult result;
+    const int step = std::max(1, options.downsample);
+
+    // Points d'évaluation (Room::samplePoints), avec leur position dans la grille grossière
+    struct Sample { int x, y, gx, gy; };
+    std::vector<Sample> samples;
+    for (size_t pixel : room.samplePoints(step)) {
+        const int x = static_cast<int>(pixel % room.width), y = static_cast<int>(pixel / room.width);
+        samples.push_back({x, y, (x - Room::BOUNDARY_MARGIN) / step, (y - Room::BOUNDARY_MARGIN) / step});
+    }
+    if (samples.empty() || options.emitterCount <= 0) return result;
+    const size_t words = (samples.size() + 63) / 64;
+
+    // Positions candidates : un point libre sur candidateStep
+    const int cstep = std::max(1, options.candidateStep);
+    std::vector<Candidate> candidates;
+    int gridWidth = 0, gridHeight = 0;
+    for (const auto& s : samples) {
+        if (s.gx % cstep == 0 && s.gy % cstep == 0) {
+            candidates.push_back({s.x, s.y, s.gx / cstep, s.gy / cstep});
+            gridWidth = std::max(gridWidth, s.gx / cstep + 1);
+            gridHeight = std::max(gridHeight, s.gy / cstep + 1);
+        }
+    }
+    std::vector<int> candidateAt(static_cast<size_t>(gridWidth) * gridHeight, -1);
+    for (size_t c = 0; c < candidates.size(); c++) {
+        candidateAt[static_cast<size_t>(candidates[c].gy) * gridWidth + candidates[c].gx] = static_cast<int>(c);
+    }
+
+    // Puissance reçue d'une position en un point, obstacles compris
+    auto receivedPower = [&](const Emitter& emitter, int x, int y) {
+        double power = room.model.power(emitter, x, y);
+        if (power < options.threshold) return power; // Déjà sous le seuil sans obstacle
+        for (const auto& obstacle : room.obstacles) {
+            if (obstacle->isBlocking(x, y, emitter.getX(), emitter.getY())) {
+                power -= obstacle->getAttenuation();
+                if (power < options.threshold) break;
+            }
+        }
+        return power;
+    };
+
+    // Couverture déjà assurée par les émetteurs présents
+    PointSet base(words, 0);
+    const int blocks = static_cast<int>(words);
+    parallelFor(blocks, options.threads, [&](int b) {
+        for (size_t s = static_cast<size_t>(b) * 64; s < std::min(samples.size(), static_cast<size_t>(b + 1) * 64); s++) {
+            for (const auto& emitter : room.emitters) {
+                if (receivedPower(emitter, samples[s].x, samples[s].y) >= options.threshold) {
+                    base[b] |= uint64_t(1) << (s % 64);
+                    break;
+                }
+            }
+        }
+    });
+
+    // Couche de chaque candidat, calculée une fois et réduite aux points couverts en plus de la base
+    std::vector<PointSet> layers(candidates.size(), PointSet(words, 0));
+    parallelFor(static_cast<int>(candidates.size()), options.threads, [&](int c) {
+        const Emitter emitter(candidates[c].x, candidates[c].y, options.power, options.frequency);
+        PointSet& layer = layers[c];
+        for (size_t s = 0; s < samples.size(); s++) {
+            if (base[s / 64] >> (s % 64) & 1) continue;
+            if (receivedPower(emitter, samples[s].x, samples[s].y) >= options.threshold) {
+                layer[s / 64] |= uint64_t(1) << (s % 64);
+            }
+        }
+    });
+
+    // Placement glouton : à chaque étape, le candidat qui ajoute le plus de points couverts
+    std::vector<int> chosen;
+    PointSet covered = base;
+    std::vector<int> scores(candidates.size());
+    for (int k = 0; k < options.emitterCount; k++) {
+        parallelFor(static_cast<int>(candidates.size()), options.threads, [&](int c) {
+            scores[c] = countUnion(covered, layers[c]);
+        });
+        result.evaluations += static_cast<long>(candidates.size());
+        const int best = static_cast<int>(std::max_element(scores.begin(), scores.end()) - scores.begin());
+        chosen.push_back(best);
+        addPoints(covered, layers[best]);
+    }
+
+    // Recuit simulé : déplacer un émetteur vers un candidat voisin ou quelconque
+    std::mt19937 rng(options.seed);
+    int currentScore = countPoints(covered);
+    std::vector<int> bestChosen = chosen;
+    int bestScore = currentScore;
+    const int threads = options.threads > 0 ? options.threads : hardwareThreads();
+    const int batch = 8 * threads;
+
+    struct Move { int slot, candidate, score; };
+    std::vector<Move> moves(batch);
+    std::vector<PointSet> others(chosen.size(), PointSet(words, 0));
+
+    auto computeOthers = [&]() {
+        for (size_t i = 0; i < chosen.size(); i++) {
+            others[i] = base;
+            for (size_t j = 0; j < chosen.size(); j++) {
+                if (j != i) addPoints(others[i], layers[chosen[j]]);
+            }
+        }
+    };
+    computeOthers();
+
+    std::uniform_int_distribution<int> slotDist(0, static_cast<int>(chosen.size()) - 1);
+    std::uniform_int_distribution<int> candidateDist(0, static_cast<int>(candidates.size()) - 1);
+    std::uniform_int_distribution<int> offsetDist(-2, 2);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    const int total = static_cast<int>(samples.size());
+    for (int it = 0; it < options.iterations && bestScore < total; it++) {
+        // Propositions tirées séquentiellement (reproductibles), évaluées en parallèle
+        for (auto& move : moves) {
+            move.slot = slotDist(rng);
+            move.candidate = candidateDist(rng);
+            if (unit(rng) < 0.5) {
+                const Candidate& from = candidates[chosen[move.slot]];
+                const int gx = from.gx + offsetDist(rng), gy = from.gy + offsetDist(rng);
+                if (gx >= 0 && gx < gridWidth && gy >= 0 && gy < gridHeight) {
+                    const int neighbour = candidateAt[static_cast<size_t>(gy) * gridWidth + gx];
+                    if (neighbour >= 0) move.candidate = neighbour;
+                }
+            }
+        }
+        parallelFor(batch, threads, [&](int m) {
+            moves[m].score = countUnion(others[moves[m].slot], layers[moves[m].candidate]);
+        });
+        result.evaluations += batch;
+
+        const Move& move = *std::max_element(moves.begin(), moves.end(),
+                                             [](const Move& a, const Move& b) { return a.score < b.score; });
+        const double temperature = options.temperature * samples.size() * (1.0 - static_cast<double>(it) / options.iterations);
+        const int delta = move.score - currentScore;
+        if (delta >= 0 || (temperature > 0 && unit(rng) < std::exp(delta / temperature))) {
+            chosen[move.slot] = move.candidate;
+            currentScore = move.score;
+            computeOthers();
+            if (currentScore > bestScore) {
+                bestScore = currentScore;
+                bestChosen = chosen;
+            }
+        }
+    }
+
+    for (int c : bestChosen) {
+        result.emitters.push_back(Emitter(candidates[c].x, candidates[c].y, options.power, options.frequency));
+    }
+    result.coverage = static_cast<double>(bestScore) / samples.size();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Placement de " << options.emitterCount << " emetteur(s): couverture "
+              << 100.0 * result.coverage << "% (" << result.evaluations << " configurations evaluees en "
+              << result.seconds << " s)" << std::endl;
+    return result;
+}
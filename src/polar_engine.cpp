@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <cmath>
+
+#include "../headers/polar_engine.hpp"
+#include "../headers/parallel.hpp"
+
+namespace {
+
+const double TWO_PI = 2.0 * M_PI;
+const int DIRECTIONS_PER_TASK = 256;
+
+} // namespace
+
+PolarEngine::PolarEngine(const Room& room, int threads, size_t first, size_t end)
+: obstacles(room.obstacles.begin(), room.obstacles.end()) {
+    firstEmitter = std::min(first, room.emitters.size());
+    endEmitter = std::max(firstEmitter, std::min(end, room.emitters.size()));
+    grids.resize(endEmitter - firstEmitter);
+    for (size_t e = firstEmitter; e < endEmitter; e++) {
+        PolarGrid& grid = grids[e - firstEmitter];
+        grid.x = room.emitters[e].getX();
+        grid.y = room.emitters[e].getY();
+        buildGrid(grid, gridRadius(room, e), threads);
+    }
+}
+
+double PolarEngine::gridRadius(const Room& room, size_t emitter) {
+    const double x = room.emitters[emitter].getX(), y = room.emitters[emitter].getY();
+    double farthest = 0.0;
+    for (int cx : {0, room.width - 1}) {
+        for (int cy : {0, room.height - 1}) farthest = std::max(farthest, std::hypot(cx - x, cy - y));
+    }
+    // Au-delà de sa portée, l'émetteur reste sous le plancher quelle que soit l'occlusion lue
+    if (room.obstaclesOnlyAttenuate()) farthest = std::min(farthest, room.model.range(room.emitters[emitter], Room::NOISE_FLOOR));
+    return farthest;
+}
+
+void PolarEngine::gridShape(double radius, int& directions, int& radii) {
+    directions = std::max(64, static_cast<int>(std::ceil(TWO_PI * (radius + 1.0) / SAMPLE_SPACING)));
+    radii = static_cast<int>(std::ceil((radius + 1.0) / SAMPLE_SPACING)) + 1;
+}
+
+size_t PolarEngine::groupEnd(const Room& room, size_t first) {
+    size_t end = first, bytes = 0;
+    while (end < room.emitters.size()) {
+        int directions, radii;
+        gridShape(gridRadius(room, end), directions, radii);
+        bytes += static_cast<size_t>(directions) * radii * sizeof(int16_t);
+        if (bytes > GROUP_BUDGET && end > first) break;
+        end++;
+    }
+    return end;
+}
+
+void PolarEngine::buildGrid(PolarGrid& grid, double radius, int threads) const {
+    gridShape(radius, grid.directions, grid.radii);
+    grid.step = TWO_PI / grid.directions;
+    grid.totals.resize(static_cast<size_t>(grid.directions) * grid.radii);
+
+    const std::vector<ObstacleSector> sectors = obstacleSectors(obstacles, grid.x, grid.y, grid.directions);
+    std::vector<uint32_t> start, candidates;
+    sectorCandidates(sectors, grid.directions, start, candidates);
+
+    const int tasks = (grid.directions + DIRECTIONS_PER_TASK - 1) / DIRECTIONS_PER_TASK;
+    parallelFor(tasks, threads, [&](int t) {
+        std::vector<double> entering(grid.radii);
+        for (int i = t * DIRECTIONS_PER_TASK; i < std::min(grid.directions, (t + 1) * DIRECTIONS_PER_TASK); i++) {
+            const double dir_x = std::cos(i * grid.step), dir_y = std::sin(i * grid.step);
+
+            // Premier échantillon de la direction dans chaque obstacle candidat
+            std::fill(entering.begin(), entering.end(), 0.0);
+            for (uint32_t c = start[i]; c < start[i + 1]; c++) {
+                const ObstacleSector& s = sectors[candidates[c]];
+                const int j0 = static_cast<int>(std::ceil(s.nearRadius / SAMPLE_SPACING));
+                const int j1 = std::min(grid.radii - 1, static_cast<int>(std::floor(s.farRadius / SAMPLE_SPACING)));
+                for (int j = j0; j <= j1; j++) {
+                    const double r = j * SAMPLE_SPACING;
+                    if (obstacles[candidates[c]]->isPointInside(grid.x + r * dir_x, grid.y + r * dir_y)) {
+                        entering[j] += obstacles[candidates[c]]->getAttenuation();
+                        break;
+                    }
+                }
+            }
+
+            // Somme préfixe le long de la direction
+            int16_t* line = grid.totals.data() + static_cast<size_t>(i) * grid.radii;
+            double total = 0.0;
+            for (int j = 0; j < grid.radii; j++) {
+                total += entering[j];
+                line[j] = static_cast<int16_t>(std::max(-32768.0, std::min(32767.0, std::nearbyint(total * 100.0))));
+            }
+        }
+    });
+}
+
+double PolarEngine::occlusion(size_t emitter, int x, int y, std::vector<uint32_t>& /*scratch*/) const {
+    const PolarGrid& grid = grids[emitter - firstEmitter];
+    const double dx = x - grid.x, dy = y - grid.y;
+    double angle = std::atan2(dy, dx);
+    if (angle < 0) angle += TWO_PI;
+
+    // Échantillon polaire le plus proche
+    int i = static_cast<int>(std::lround(angle / grid.step));
+    if (i >= grid.directions) i -= grid.directions;
+    const int j = std::min(grid.radii - 1, static_cast<int>(std::lround(std::hypot(dx, dy) / SAMPLE_SPACING)));
+    return grid.totals[static_cast<size_t>(i) * grid.radii + j] / 100.0;
+}
@@ -0,0 +1,159 @@
+#include <cmath>
+
+#include "../headers/propagation_model.hpp"
+
+namespace {
+
+const double SPEED_OF_LIGHT = 3e8;  // en m/s
+const double NEAR_FIELD = 0.001;    // Distance du champ proche (m)
+
+// Coefficients des modèles, précalculés par appel du noyau : 10·n, 10·n2, cassure et perte à la cassure
+template <typename Scalar>
+struct DistanceCoefficients {
+    Scalar slope, farSlope, breakpoint, breakLoss;
+
+    explicit DistanceCoefficients(const PropagationModel& model)
+    : slope(static_cast<Scalar>(10 * model.exponent)),
+      farSlope(static_cast<Scalar>(10 * model.farExponent)),
+      breakpoint(static_cast<Scalar>(model.breakpoint)),
+      breakLoss(static_cast<Scalar>(10 * model.exponent * std::log10(model.breakpoint))) {}
+};
+
+// Perte de distance du modèle L pour une distance d (m) hors champ proche
+template <PathLoss L, typename Scalar>
+Scalar distanceLoss(Scalar d, const DistanceCoefficients<Scalar>& k) {
+    if (L == PathLoss::FreeSpace) return 20 * std::log10(d);
+    if (L == PathLoss::LogDistance) return k.slope * std::log10(d);
+    return d <= k.breakpoint ? k.slope * std::log10(d) : k.breakLoss + k.farSlope * std::log10(d / k.breakpoint);
+}
+
+/**
+ * Noyau spécialisé : modèle, type des calculs et résolution connus à la compilation
+ * (Resolution = 0 : résolution lue dans le modèle). En double et en espace libre, même
+ * résultat au bit près que Emitter::computePower
+ */
+template <PathLoss L, typename Scalar, int Resolution>
+void powerKernel(const PropagationModel& model, const Emitter& emitter,
+                 const double* xs, const double* ys, int count, double* out) {
+    const Scalar resolution = static_cast<Scalar>(Resolution > 0 ? Resolution : model.resolution);
+    const Scalar ex = static_cast<Scalar>(emitter.getX()), ey = static_cast<Scalar>(emitter.getY());
+    const Scalar power = static_cast<Scalar>(emitter.power);
+    const Scalar frequencyTerm = static_cast<Scalar>(20 * std::log10(emitter.frequency));
+    const Scalar constantTerm = static_cast<Scalar>(20 * std::log10(4 * M_PI / SPEED_OF_LIGHT));
+    const DistanceCoefficients<Scalar> k(model);
+
+    for (int i = 0; i < count; i++) {
+        const Scalar dx = (static_cast<Scalar>(xs[i]) - ex) / resolution;
+        const Scalar dy = (static_cast<Scalar>(ys[i]) - ey) / resolution;
+        const Scalar d = std::sqrt(dx * dx + dy * dy);
+        if (d < static_cast<Scalar>(NEAR_FIELD)) {
+            out[i] = emitter.power; // Éviter la division par zéro
+            continue;
+        }
+        out[i] = power - (distanceLoss<L, Scalar>(d, k) + frequencyTerm + constantTerm);
+    }
+}
+
+template <PathLoss L, typename Scalar>
+PowerKernel selectResolution(int resolution) {
+    switch (resolution) {
+        case 10: return powerKernel<L, Scalar, 10>;
+        case 50: return powerKernel<L, Scalar, 50>;
+        case 100: return powerKernel<L, Scalar, 100>;
+        default: return powerKernel<L, Scalar, 0>;
+    }
+}
+
+template <PathLoss L>
+PowerKernel selectPrecision(Precision precision, int resolution) {
+    if (precision == Precision::Float) return selectResolution<L, float>(resolution);
+    return selectResolution<L, double>(resolution);
+}
+
+} // namespace
+
+const char* pathLossName(PathLoss pathLoss) {
+    switch (pathLoss) {
+        case PathLoss::LogDistance: return "logdistance";
+        case PathLoss::DualSlope: return "dualslope";
+        default: return "freespace";
+    }
+}
+
+bool parsePathLoss(const std::string& name, PathLoss& pathLoss) {
+    for (PathLoss candidate : {PathLoss::FreeSpace, PathLoss::LogDistance, PathLoss::DualSlope}) {
+        if (name == pathLossName(candidate)) {
+            pathLoss = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* precisionName(Precision precision) {
+    return precision == Precision::Float ? "float" : "double";
+}
+
+bool parsePrecision(const std::string& name, Precision& precision) {
+    for (Precision candidate : {Precision::Double, Precision::Float}) {
+        if (name == precisionName(candidate)) {
+            precision = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PropagationModel::isValid() const {
+    return exponent > 0 && farExponent > 0 && breakpoint > 0 && resolution >= 1;
+}
+
+double PropagationModel::power(const Emitter& emitter, double x_target, double y_target) const {
+    double result;
+    selectPowerKernel(*this, Precision::Double)(*this, emitter, &x_target, &y_target, 1, &result);
+    return result;
+}
+
+bool PropagationModel::distanceGain(double emitter_x, double emitter_y, double x_target, double y_target, double& gain) const {
+    const double dx = (x_target - emitter_x) / resolution;
+    const double dy = (y_target - emitter_y) / resolution;
+    const double d = std::sqrt(dx * dx + dy * dy);
+    if (d < NEAR_FIELD) return false;
+
+    const DistanceCoefficients<double> k(*this);
+    switch (pathLoss) {
+        case PathLoss::LogDistance: gain = -distanceLoss<PathLoss::LogDistance, double>(d, k); break;
+        case PathLoss::DualSlope: gain = -distanceLoss<PathLoss::DualSlope, double>(d, k); break;
+        default: gain = -distanceLoss<PathLoss::FreeSpace, double>(d, k); break;
+    }
+    return true;
+}
+
+double PropagationModel::range(const Emitter& emitter, double floor) const {
+    // Perte de distance admissible avant d'atteindre floor
+    const double budget = emitter.power - floor - Emitter::frequencyLoss(emitter.frequency);
+    double d; // en mètres
+    switch (pathLoss) {
+        case PathLoss::LogDistance:
+            d = std::pow(10.0, budget / (10 * exponent));
+            break;
+        case PathLoss::DualSlope: {
+            const double breakLoss = 10 * exponent * std::log10(breakpoint);
+            d = budget <= breakLoss ? std::pow(10.0, budget / (10 * exponent))
+                                    : breakpoint * std::pow(10.0, (budget - breakLoss) / (10 * farExponent));
+            break;
+        }
+        default:
+            d = std::pow(10.0, budget / 20);
+            break;
+    }
+    return d * resolution * (1 + 1e-6) + 1.0;
+}
+
+PowerKernel selectPowerKernel(const PropagationModel& model, Precision precision) {
+    switch (model.pathLoss) {
+        case PathLoss::LogDistance: return selectPrecision<PathLoss::LogDistance>(precision, model.resolution);
+        case PathLoss::DualSlope: return selectPrecision<PathLoss::DualSlope>(precision, model.resolution);
+        default: return selectPrecision<PathLoss::FreeSpace>(precision, model.resolution);
+    }
+}
@@ -0,0 +1,232 @@
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include "../headers/query_service.hpp"
+#include "../headers/scene.hpp"
+#include "../headers/map_cache.hpp"
+
+QueryService::QueryService(const std::string& cacheDirectory, int threads)
+: cacheDirectory(cacheDirectory), threads(threads) {}
+
+std::string QueryService::handle(const std::string& request) {
+    std::istringstream in(request);
+    std::string command, name;
+    in >> command;
+
+    if (command == "SCENES") {
+        std::lock_guard<std::mutex> lock(scenesMutex);
+        std::string reply = "OK";
+        for (const auto& entry : scenes) reply += " " + entry.first;
+        return reply;
+    }
+
+    if (!(in >> name)) return "ERR requete incomplete";
+
+    if (command == "LOAD") {
+        std::string filename;
+        if (!(in >> filename)) return "ERR fichier de scene manquant";
+        return load(name, filename);
+    }
+    if (command == "UNLOAD") {
+        std::lock_guard<std::mutex> lock(scenesMutex);
+        return scenes.erase(name) ? "OK" : "ERR scene inconnue";
+    }
+    if (command == "EDIT") {
+        std::string operation;
+        std::getline(in, operation);
+        return edit(name, operation);
+    }
+
+    // Requêtes de lecture : sur l'instantané courant, sans verrou pendant le calcul
+    std::shared_ptr<const Snapshot> s = snapshot(name);
+    if (!s) return "ERR scene inconnue";
+
+    if (command == "POINT") {
+        double x, y;
+        if (!(in >> x >> y)) return "ERR coordonnees manquantes";
+        return point(*s, x, y);
+    }
+    if (command == "REGION") {
+        int x0, y0, x1, y1;
+        if (!(in >> x0 >> y0 >> x1 >> y1)) return "ERR region incomplete";
+        return region(*s, x0, y0, x1, y1);
+    }
+    if (command == "TILE") {
+        int tx, ty;
+        if (!(in >> tx >> ty)) return "ERR indices de tuile manquants";
+        return tile(*s, tx, ty);
+    }
+    return "ERR commande inconnue: " + command;
+}
+
+std::shared_ptr<QueryService::Scene> QueryService::findScene(const std::string& name) {
+    std::lock_guard<std::mutex> lock(scenesMutex);
+    auto it = scenes.find(name);
+    return it == scenes.end() ? nullptr : it->second;
+}
+
+std::shared_ptr<const QueryService::Snapshot> QueryService::snapshot(const std::string& name) {
+    std::lock_guard<std::mutex> lock(scenesMutex);
+    auto it = scenes.find(name);
+    return it == scenes.end() ? nullptr : it->second->current;
+}
+
+bool QueryService::publish(const std::string& name, const std::shared_ptr<Scene>& scene, std::shared_ptr<const Snapshot> snapshot) {
+    std::lock_guard<std::mutex> lock(scenesMutex);
+    auto it = scenes.find(name);
+    if (it == scenes.end() || it->second != scene) return false;
+    scene->current = std::move(snapshot);
+    return true;
+}
+
+std::string QueryService::load(const std::string& name, const std::string& filename) {
+    Room* loaded = loadScene(filename);
+    if (!loaded) return "ERR chargement impossible: " + filename;
+
+    // Les obstacles passent sous la responsabilité du pool de la scène
+    auto pool = std::make_shared<ObstaclePool>();
+    for (Obstacle* obstacle : loaded->obstacles) pool->obstacles.emplace_back(obstacle);
+    auto next = std::make_shared<Snapshot>(Snapshot{std::move(*loaded), pool});
+    delete loaded;
+
+    Room& room = next->room;
+    room.threads = threads;
+    room.keepEmitterLayers = true;
+    if (cacheDirectory.empty()) {
+        room.computeSignalMap();
+    } else {
+        MapCache(cacheDirectory).computeSignalMap(room);
+    }
+    room.markObstaclesOnPowerMap();
+
+    auto scene = std::make_shared<Scene>();
+    scene->current = next;
+    {
+        std::lock_guard<std::mutex> lock(scenesMutex);
+        scenes[name] = scene;
+    }
+
+    std::ostringstream reply;
+    reply << "OK " << std::hex << std::setw(16) << std::setfill('0') << room.sceneHash()
+          << std::dec << " " << room.width << " " << room.height;
+    return reply.str();
+}
+
+std::string QueryService::edit(const std::string& name, const std::string& operation) {
+    std::shared_ptr<Scene> scene = findScene(name);
+    if (!scene) return "ERR scene inconnue";
+
+    // Une seule modification à la fois par scène, appliquée sur une copie
+    std::lock_guard<std::mutex> editLock(scene->editMutex);
+    std::shared_ptr<const Snapshot> current;
+    {
+        // Instantané de cette scène, même si le nom a été rechargé entre-temps (refusé à la publication)
+        std::lock_guard<std::mutex> lock(scenesMutex);
+        current = scene->current;
+    }
+    auto next = std::make_shared<Snapshot>(*current);
+    Room& room = next->room;
+
+    std::istringstream in(operation);
+    std::string op;
+    in >> op;
+
+    if (op == "ADD_EMITTER") {
+        double x, y, power, frequency;
+        if (!(in >> x >> y >> power >> frequency)) return "ERR emetteur incomplet";
+        room.addEmitter(Emitter(x, y, power, frequency));
+        room.computeEmitterLayer(room.emitters.size() - 1);
+    }
+    else if (op == "MOVE_EMITTER") {
+        size_t index;
+        double x, y;
+        if (!(in >> index >> x >> y) || index >= room.emitters.size()) return "ERR emetteur invalide";
+        room.emitters[index].x = x;
+        room.emitters[index].y = y;
+        room.computeEmitterLayer(index);
+    }
+    else if (op == "DELETE_EMITTER") {
+        double x, y;
+        if (!(in >> x >> y)) return "ERR coordonnees manquantes";
+        if (!room.deleteEmitter(x, y)) return "ERR emetteur introuvable";
+    }
+    else if (op == "ADD") {
+        std::string declaration;
+        std::getline(in, declaration);
+        Obstacle* obstacle = parseObstacle(declaration);
+        if (!obstacle) return "ERR obstacle invalide";
+        next->pool->obstacles.emplace_back(obstacle);
+        room.addObstacle(obstacle);
+        room.applyObstacleToLayers(obstacle, 1.0);
+    }
+    else if (op == "DELETE_OBSTACLE") {
+        double x1, y1, x2, y2;
+        if (!(in >> x1 >> y1 >> x2 >> y2)) return "ERR coordonnees manquantes";
+        // L'obstacle reste dans le pool tant que d'anciens instantanés peuvent l'utiliser
+        if (!room.deleteObstacle(x1, y1, x2, y2)) return "ERR obstacle introuvable";
+    }
+    else {
+        return "ERR modification inconnue: " + op;
+    }
+
+    room.combineEmitterLayers();
+    room.markObstaclesOnPowerMap();
+    if (!publish(name, scene, next)) return "ERR scene dechargee ou rechargee pendant la modification";
+
+    std::ostringstream reply;
+    reply << "OK " << std::hex << std::setw(16) << std::setfill('0') << room.sceneHash();
+    return reply.str();
+}
+
+std::string QueryService::point(const Snapshot& s, double x, double y) const {
+    const int px = static_cast<int>(std::lround(x));
+    const int py = static_cast<int>(std::lround(y));
+    if (px < 0 || px >= s.room.width || py < 0 || py >= s.room.height) return "ERR point hors de la salle";
+
+    const double value = s.room.getPower(px, py);
+    if (value == -555) return "OK OBSTACLE";
+    std::ostringstream reply;
+    reply << "OK " << value;
+    return reply.str();
+}
+
+std::string QueryService::region(const Snapshot& s, int x0, int y0, int x1, int y1) const {
+    x0 = std::max(0, x0);
+    y0 = std::max(0, y0);
+    x1 = std::min(s.room.width, x1);
+    y1 = std::min(s.room.height, y1);
+
+    double minPower = 0, maxPower = 0, sum = 0;
+    long count = 0;
+    for (int y = y0; y < y1; y++) {
+        for (int x = x0; x < x1; x++) {
+            const double value = s.room.getPower(x, y);
+            if (value == -555) continue;
+            if (count == 0) minPower = maxPower = value;
+            minPower = std::min(minPower, value);
+            maxPower = std::max(maxPower, value);
+            sum += value;
+            count++;
+        }
+    }
+    if (count == 0) return "ERR aucun point libre dans la region";
+
+    std::ostringstream reply;
+    reply << "OK " << minPower << " " << maxPower << " " << sum / count << " " << count;
+    return reply.str();
+}
+
+std::string QueryService::tile(const Snapshot& s, int tx, int ty) const {
+    const int x0 = tx * Room::TILE_SIZE, y0 = ty * Room::TILE_SIZE;
+    if (tx < 0 || ty < 0 || x0 >= s.room.width || y0 >= s.room.height) return "ERR tuile hors de la salle";
+    const int x1 = std::min(x0 + Room::TILE_SIZE, s.room.width);
+    const int y1 = std::min(y0 + Room::TILE_SIZE, s.room.height);
+
+    std::ostringstream reply;
+    reply << "OK " << x0 << " " << y0 << " " << x1 << " " << y1;
+    for (int y = y0; y < y1; y++) {
+        for (int x = x0; x < x1; x++) reply << " " << s.room.getPower(x, y);
+    }
+    return reply.str();
+}
@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "../headers/ray_fan.hpp"
+#include "../headers/parallel.hpp"
+
+namespace {
+
+const double TWO_PI = 2.0 * M_PI;
+const double RADIUS_TOLERANCE = 1e-3; // Précision de la distance d'entrée (pixels)
+const int RAYS_PER_TASK = 256;
+
+// Signature d'un obstacle, sommée le long des rayons pour comparer les obstacles traversés
+uint64_t obstacleSignature(uint32_t k) {
+    uint64_t h = (k + 1) * 0x9E3779B97F4A7C15ull;
+    h ^= h >> 31;
+    return h * 0xBF58476D1CE4E5B9ull;
+}
+
+} // namespace
+
+RayFanEngine::RayFanEngine(const Room& room, int threads, bool exactness)
+: width(room.width), height(room.height), obstacles(room.obstacles.begin(), room.obstacles.end()), exactness(exactness) {
+    fans.resize(room.emitters.size());
+    for (size_t e = 0; e < room.emitters.size(); e++) {
+        fans[e].x = room.emitters[e].getX();
+        fans[e].y = room.emitters[e].getY();
+        buildFan(fans[e], threads);
+    }
+}
+
+void RayFanEngine::buildFan(Fan& fan, int threads) const {
+    // Assez de rayons pour que deux rayons voisins restent à moins de RAY_SPACING au coin le plus lointain
+    double farthest = 0.0;
+    for (int cx : {0, width - 1}) {
+        for (int cy : {0, height - 1}) farthest = std::max(farthest, std::hypot(cx - fan.x, cy - fan.y));
+    }
+    fan.rays = std::max(64, static_cast<int>(std::ceil(TWO_PI * (farthest + 1.0) / RAY_SPACING)));
+    fan.step = TWO_PI / fan.rays;
+
+    // Secteur de rayons couvert par la boîte englobante de chaque obstacle
+    const std::vector<ObstacleSector> sectors = obstacleSectors(obstacles, fan.x, fan.y, fan.rays);
+
+    // Listes de candidats par rayon, dans l'ordre des obstacles
+    sectorCandidates(sectors, fan.rays, fan.candidateStart, fan.candidates);
+
+    // Distance d'entrée du rayon dans chaque candidat, par dichotomie sur isBlocking : pour un
+    // obstacle convexe, le segment émetteur -> point reste bloqué une fois l'obstacle atteint.
+    // MurDroit::isBlocking ignore les extrémités (un rayon qui sort par l'une n'est plus bloqué) :
+    // ses points sont toujours vérifiés, à partir de l'entrée dans sa boîte (atténuation NAN)
+    struct Entry {
+        double radius;
+        uint32_t obstacle;
+    };
+    std::vector<std::vector<Entry>> entries(fan.rays);
+    const int tasks = (fan.rays + RAYS_PER_TASK - 1) / RAYS_PER_TASK;
+    parallelFor(tasks, threads, [&](int t) {
+        for (int i = t * RAYS_PER_TASK; i < std::min(fan.rays, (t + 1) * RAYS_PER_TASK); i++) {
+            const double dir_x = std::cos(i * fan.step), dir_y = std::sin(i * fan.step);
+            auto blocked = [&](const Obstacle* obstacle, double r) {
+                return obstacle->isBlocking(fan.x + r * dir_x, fan.y + r * dir_y, fan.x, fan.y);
+            };
+            for (uint32_t c = fan.candidateStart[i]; c < fan.candidateStart[i + 1]; c++) {
+                const uint32_t k = fan.candidates[c];
+                double lo = sectors[k].nearRadius, hi = sectors[k].farRadius;
+                if (dynamic_cast<const MurDroit*>(obstacles[k])) {
+                    entries[i].push_back({lo, k});
+                    continue;
+                }
+                if (!blocked(obstacles[k], hi)) continue; // Au-delà de la boîte : le rayon ne la croise pas
+                if (!blocked(obstacles[k], lo)) {
+                    while (hi - lo > RADIUS_TOLERANCE) {
+                        const double mid = (lo + hi) / 2;
+                        if (blocked(obstacles[k], mid)) hi = mid;
+                        else lo = mid;
+                    }
+                } else {
+                    hi = lo;
+                }
+                entries[i].push_back({hi, k});
+            }
+            std::sort(entries[i].begin(), entries[i].end(), [](const Entry& u, const Entry& v) { return u.radius < v.radius; });
+        }
+    });
+
+    fan.entryStart.assign(fan.rays + 1, 0);
+    for (int i = 0; i < fan.rays; i++) {
+        fan.entryStart[i + 1] = fan.entryStart[i] + static_cast<uint32_t>(entries[i].size());
+        double total = 0.0;
+        uint64_t signature = 0;
+        for (const Entry& entry : entries[i]) {
+            // Un total NAN reste NAN : tout point au-delà d'un MurDroit est vérifié
+            const bool verified = dynamic_cast<const MurDroit*>(obstacles[entry.obstacle]) != nullptr;
+            total += verified ? NAN : obstacles[entry.obstacle]->getAttenuation();
+            signature += obstacleSignature(entry.obstacle);
+            fan.entryRadius.push_back(entry.radius);
+            fan.entryTotal.push_back(total);
+            fan.entrySignature.push_back(signature);
+        }
+        std::vector<Entry>().swap(entries[i]);
+    }
+}
+
+size_t RayFanEngine::crossed(const Fan& fan, int ray, double r) {
+    const auto begin = fan.entryRadius.begin() + fan.entryStart[ray];
+    const auto end = fan.entryRadius.begin() + fan.entryStart[ray + 1];
+    return std::upper_bound(begin, end, r) - fan.entryRadius.begin();
+}
+
+double RayFanEngine::occlusion(size_t emitter, int x, int y, std::vector<uint32_t>& /*scratch*/) const {
+    const double value = fanOcclusion(fans[emitter], x, y);
+    if (exactness) checkExact(fans[emitter], x, y, value);
+    return value;
+}
+
+void RayFanEngine::checkExact(const Fan& fan, int x, int y, double value) const {
+    const double error = std::abs(value - exactOcclusion(fan, x, y));
+    if (error <= MISMATCH_TOLERANCE) return; // Une valeur NAN du moteur compte comme un écart
+    mismatchCount++;
+    double worst = maxMismatch.load();
+    while (error > worst && !maxMismatch.compare_exchange_weak(worst, error)) {}
+}
+
+double RayFanEngine::fanOcclusion(const Fan& fan, int x, int y) const {
+    const double dx = x - fan.x, dy = y - fan.y;
+    const double r = std::hypot(dx, dy);
+    if (r < 2.0) return exactOcclusion(fan, x, y); // Secteurs trop étroits au pied de l'émetteur
+
+    double angle = std::atan2(dy, dx);
+    if (angle < 0) angle += TWO_PI;
+    const int a = std::min(fan.rays - 1, static_cast<int>(angle / fan.step));
+    const int b = a + 1 == fan.rays ? 0 : a + 1;
+
+    // Aucune entrée à moins de EDGE_MARGIN du pixel, et mêmes obstacles traversés par les deux
+    // rayons : pas de bord d'ombre entre eux. Sinon (ou derrière un MurDroit), calcul exact
+    const size_t ia = crossed(fan, a, r + EDGE_MARGIN), ib = crossed(fan, b, r + EDGE_MARGIN);
+    if (crossed(fan, a, r - EDGE_MARGIN) == ia && crossed(fan, b, r - EDGE_MARGIN) == ib) {
+        const bool emptyA = ia == fan.entryStart[a], emptyB = ib == fan.entryStart[b];
+        if (emptyA && emptyB) return 0.0;
+        if (!emptyA && !emptyB && fan.entrySignature[ia - 1] == fan.entrySignature[ib - 1] &&
+            !std::isnan(fan.entryTotal[ia - 1])) {
+            return fan.entryTotal[ia - 1];
+        }
+    }
+    return exactOcclusion(fan, a, b, x, y);
+}
+
+double RayFanEngine::exactOcclusion(const Fan& fan, int a, int b, int x, int y) const {
+    // Fusion des deux listes de candidats (triées par indice d'obstacle)
+    uint32_t i = fan.candidateStart[a], iEnd = fan.candidateStart[a + 1];
+    uint32_t j = fan.candidateStart[b], jEnd = fan.candidateStart[b + 1];
+    double total = 0.0;
+    while (i < iEnd || j < jEnd) {
+        uint32_t k;
+        if (j == jEnd || (i < iEnd && fan.candidates[i] < fan.candidates[j])) {
+            k = fan.candidates[i++];
+        } else if (i == iEnd || fan.candidates[j] < fan.candidates[i]) {
+            k = fan.candidates[j++];
+        } else {
+            k = fan.candidates[i++];
+            j++;
+        }
+        if (obstacles[k]->isBlocking(x, y, fan.x, fan.y)) total += obstacles[k]->getAttenuation();
+    }
+    return total;
+}
+
+double RayFanEngine::exactOcclusion(const Fan& fan, int x, int y) const {
+    double total = 0.0;
+    for (const Obstacle* obstacle : obstacles) {
+        if (obstacle->isBlocking(x, y, fan.x, fan.y)) total += obstacle->getAttenuation();
+    }
+    return total;
+}
@@ -1,35 +1,958 @@
 #include <vector>
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <cstring>
 #include "emitter.hpp"
 #include "../headers/obstacle.hpp"
 
 #include "../headers/room.hpp"
+#include "../headers/parallel.hpp"
+#include "../headers/map_reader.hpp"
+#include "../headers/attenuation_grid.hpp"
+#include "../headers/ray_fan.hpp"
+#include "../headers/polar_engine.hpp"
+#include "../headers/throughput.hpp"
 
-Room::Room(int width, int height) : width(width), height(height) {
-    powerMap.resize(height, std::vector<double>(width, -90.0)); // -90 dB par défaut (bruit de fond)
+const char* engineName(PropagationEngine engine) {
+    switch (engine) {
+        case PropagationEngine::Dda: return "dda";
+        case PropagationEngine::RayFan: return "rayfan";
+        case PropagationEngine::Polar: return "polar";
+        default: return "exact";
+    }
+}
+
+bool parseEngine(const std::string& name, PropagationEngine& engine) {
+    if (name == "exact") engine = PropagationEngine::Exact;
+    else if (name == "dda") engine = PropagationEngine::Dda;
+    else if (name == "rayfan") engine = PropagationEngine::RayFan;
+    else if (name == "polar") engine = PropagationEngine::Polar;
+    else return false;
+    return true;
+}
+
+Room::Room(int width, int height, bool allocateMap) : width(width), height(height) {
+    if (allocateMap) {
+        powerMap.resize(height, std::vector<double>(width, -90.0)); // -90 dB par défaut (bruit de fond)
+    }
 }
 
 void Room::computeSignalMap() {
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            double totalPower = -100.0; // En dB
-            
-            for (const auto& emitter : emitters) {
-                double power = emitter.computePower(x, y);
-
-                for (const auto& obstacle : obstacles) {
-                    if (obstacle->isBlocking(x, y, emitter.getX(), emitter.getY())) {
-                        power -= obstacle->getAttenuation();
+    // Couches neuves (les anciennes restent aux copies de la salle qui les partagent)
+    emitterLayers.clear();
+    std::vector<EmitterLayer*> layers;
+    if (keepEmitterLayers) {
+        if (keepCrossingCounts) {
+            materials.clear();
+            indexMaterials();
+        }
+        for (size_t e = 0; e < emitters.size(); e++) {
+            auto layer = std::make_shared<EmitterLayer>();
+            layer->geometry.resize(static_cast<size_t>(width) * height);
+            layer->nearField = nearFieldPixels(emitters[e]);
+            if (keepCrossingCounts) {
+                layer->crossings.assign(materials.size(), std::vector<uint8_t>(static_cast<size_t>(width) * height, 0));
+            }
+            layers.push_back(layer.get());
+            emitterLayers.push_back(layer);
+        }
+    }
+
+    // Rastérisation ou rayons, une fois ; couches toujours exactes (recombinées ensuite sans moteur)
+    const std::vector<Tile> grid = tiles();
+    std::unique_ptr<OcclusionEngine> occlusion = keepEmitterLayers ? nullptr : prepareEngineGroup(0);
+
+    bestServers = BestServers();
+    if (keepBestServers > 0 && !occlusion && emitters.size() < BestServers::NONE) {
+        bestServers.k = std::min(keepBestServers, BestServers::MAX_K);
+        const size_t entries = static_cast<size_t>(width) * height * bestServers.k;
+        bestServers.emitter.assign(entries, BestServers::NONE);
+        bestServers.power.assign(entries, NOISE_FLOOR);
+    }
+
+    const bool bounded = obstaclesOnlyAttenuate();
+    parallelFor(static_cast<int>(grid.size()), threads, [&](int i) {
+        computeTile(grid[i], occlusion.get(), bounded, keepEmitterLayers ? &layers : nullptr);
+    });
+
+    // Mode exact de l'éventail : bilan des points comparés au calcul exact
+    engineMismatches = 0;
+    if (const auto* fan = dynamic_cast<const RayFanEngine*>(occlusion.get())) {
+        if (engineExactness) {
+            engineMismatches = fan->mismatches();
+            std::ostringstream report; // D'un bloc : les scènes d'un lot sont calculées en parallèle
+            report << "Moteur rayfan en mode exact : " << engineMismatches << " occlusion(s) differente(s) du calcul exact";
+            if (engineMismatches > 0) report << ", ecart max " << fan->maxError() << " dB";
+            std::cout << report.str() << std::endl;
+        }
+    }
+
+    // Moteur préparé par groupes d'émetteurs (polaire) : chaque groupe suivant garde le maximum
+    while (occlusion && occlusion->endEmitter < emitters.size()) {
+        const size_t next = occlusion->endEmitter;
+        occlusion.reset(); // Grilles du groupe précédent libérées avant de préparer le suivant
+        occlusion = prepareEngineGroup(next);
+        parallelFor(static_cast<int>(grid.size()), threads, [&](int i) { computeTile(grid[i], occlusion.get(), bounded, nullptr, true); });
+    }
+}
+
+void Room::setQuantizedStorage(bool enabled) {
+    if (enabled == quantized) return;
+    const size_t size = static_cast<size_t>(width) * height;
+    if (enabled) {
+        quantizedMap.resize(size, QuantizedPower::encode(-90.0));
+        if (!powerMap.empty()) {
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++) {
+                    quantizedMap[static_cast<size_t>(y) * width + x] = QuantizedPower::encode(powerMap[y][x]);
+                }
+            }
+        }
+        std::vector<std::vector<double>>().swap(powerMap);
+    } else {
+        powerMap.assign(height, std::vector<double>(width, -90.0));
+        if (!quantizedMap.empty()) {
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++) {
+                    powerMap[y][x] = QuantizedPower::decode(quantizedMap[static_cast<size_t>(y) * width + x]);
+                }
+            }
+        }
+        std::vector<int16_t>().swap(quantizedMap);
+    }
+    quantized = enabled;
+}
+
+std::unique_ptr<PowerMapReader> Room::mapReader() const {
+    if (quantized) return std::unique_ptr<PowerMapReader>(new QuantizedMapReader(quantizedMap, width, height));
+    return std::unique_ptr<PowerMapReader>(new InMemoryMapReader(powerMap));
+}
+
+std::vector<Tile> Room::tiles() const {
+    std::vector<Tile> result;
+    for (int y0 = 0; y0 < height; y0 += TILE_SIZE) {
+        for (int x0 = 0; x0 < width; x0 += TILE_SIZE) {
+            result.push_back({x0, y0, std::min(x0 + TILE_SIZE, width), std::min(y0 + TILE_SIZE, height)});
+        }
+    }
+    return result;
+}
+
+void Room::computeTile(const Tile& tile, const OcclusionEngine* occlusion, bool bounded,
+                       const std::vector<EmitterLayer*>* layers, bool accumulate) {
+    std::vector<double> power(static_cast<size_t>(TILE_SIZE) * TILE_SIZE);
+    BestServers* servers = bestServers.k > 0 ? &bestServers : nullptr;
+    if (layers) {
+        // Même passe par paquets, décomposée en couche géométrique et décalage pour chaque émetteur
+        if (precision == Precision::Float) computeExactTilePower<float>(tile, bounded, power.data(), TILE_SIZE, servers, layers);
+        else computeExactTilePower<double>(tile, bounded, power.data(), TILE_SIZE, servers, layers);
+    } else {
+        computeTilePower(tile, occlusion, bounded, power.data(), TILE_SIZE, servers);
+    }
+    for (int y = tile.y0; y < tile.y1; y++) {
+        for (int x = tile.x0; x < tile.x1; x++) {
+            const double value = power[static_cast<size_t>(y - tile.y0) * TILE_SIZE + (x - tile.x0)];
+            setPower(x, y, accumulate ? std::max(getPower(x, y), value) : value);
+        }
+    }
+}
+
+void Room::computeTilePower(const Tile& tile, const OcclusionEngine* occlusion, bool bounded, double* out, size_t stride,
+                            BestServers* servers) const {
+    if (occlusion) {
+        std::vector<uint32_t> scratch;
+        for (int y = tile.y0; y < tile.y1; y++) {
+            double* row = out + static_cast<size_t>(y - tile.y0) * stride;
+            for (int x = tile.x0; x < tile.x1; x++) row[x - tile.x0] = computePointPower(x, y, occlusion, scratch);
+        }
+        return;
+    }
+    if (precision == Precision::Float) computeExactTilePower<float>(tile, bounded, out, stride, servers, nullptr);
+    else computeExactTilePower<double>(tile, bounded, out, stride, servers, nullptr);
+}
+
+bool Room::obstaclesOnlyAttenuate() const {
+    for (const Obstacle* obstacle : obstacles) {
+        if (obstacle->getAttenuation() < 0) return false;
+    }
+    return true;
+}
+
+namespace {
+
+// Vrai si candidate dépasse current sur au moins une voie du paquet
+template <typename Scalar>
+bool beats(const Scalar* candidate, const Scalar* current) {
+    bool any = false;
+    for (int i = 0; i < Obstacle::PACKET_SIZE; i++) any |= candidate[i] > current[i];
+    return any;
+}
+
+/**
+ * mw[i] = 10^(dbm[i] / 10) au-dessus de floor, 0 en dessous, pour un paquet
+ * Sans appel de bibliothèque : std::exp n'est pas vectorisé à -O2, cette boucle l'est (opérations
+ * flottantes, décalages et masques entiers sur les bits des doubles) avec -fno-trapping-math, qui
+ * autorise GCC à calculer les deux côtés des sélections. Écart relatif à std::exp de l'ordre de 1e-15
+ */
+void decibelsToMilliwatts(const double* dbm, double floor, double* mw) {
+    constexpr int P = Obstacle::PACKET_SIZE;
+    const double log2Scale = std::log2(10.0) / 10;        // 10^(p/10) = 2^(p·log2(10)/10)
+    const double ln2High = 0.693145751953125;              // ln(2) en deux parties (Cody-Waite) :
+    const double ln2Low = 1.42860682030941723212e-6;       // k·ln2High exact pour |k| < 2^11
+    const double shifter = 6755399441055744.0;             // 1.5·2^52 : arrondi entier, k dans les bits bas
+    double in[P], out[P];
+    std::copy(dbm, dbm + P, in);
+    for (int i = 0; i < P; i++) {
+        // Bornée : les voies sous le plancher (ou aberrantes) restent dans le domaine de 2^k
+        const double low = in[i] > floor ? in[i] : floor;
+        const double p = low < 1000.0 ? low : 1000.0;
+        const double shifted = p * log2Scale + shifter;
+        const double k = shifted - shifter;
+        const double r = p * (std::log(10.0) / 10) - k * ln2High - k * ln2Low; // |r| <= ln(2)/2
+        // e^r (Taylor jusqu'à r^13 : reste < 1e-17) par Estrin : chaîne de dépendances de 4
+        // multiplications au lieu de 13 par Horner
+        const double r2 = r * r, r4 = r2 * r2, r8 = r4 * r4;
+        const double a0 = 1.0 + r, a1 = 1.0 / 2 + r * (1.0 / 6), a2 = 1.0 / 24 + r * (1.0 / 120);
+        const double a3 = 1.0 / 720 + r * (1.0 / 5040), a4 = 1.0 / 40320 + r * (1.0 / 362880);
+        const double a5 = 1.0 / 3628800 + r * (1.0 / 39916800), a6 = 1.0 / 479001600 + r * (1.0 / 6227020800);
+        const double b0 = a0 + r2 * a1, b1 = a2 + r2 * a3, b2 = a4 + r2 * a5;
+        const double e = (b0 + r4 * b1) + r8 * (b2 + r4 * a6);
+        // 2^k : k + 1023 posé dans l'exposant (bits bas de shifted)
+        uint64_t bits, scaleBits;
+        std::memcpy(&bits, &shifted, sizeof(bits));
+        scaleBits = (bits + 1023) << 52;
+        double scale;
+        std::memcpy(&scale, &scaleBits, sizeof(scale));
+        // Masque multiplié plutôt que sélection : une fois floor propagé (appel inliné), GCC ne
+        // vectorise plus la sélection de e * scale
+        out[i] = (in[i] > floor ? 1.0 : 0.0) * (e * scale);
+    }
+    std::copy(out, out + P, mw);
+}
+
+/**
+ * Retranche d'un paquet les atténuations des obstacles classés d'un émetteur (Room::TileObstacle)
+ * Si stop n'est pas nul, s'arrête dès que power ne dépasse plus stop sur aucune voie
+ */
+template <typename Candidates, typename Scalar>
+void subtractObstacles(const Candidates& classified, const Scalar* xs, const Scalar* ys, Scalar* power, const Scalar* stop) {
+    constexpr int P = Obstacle::PACKET_SIZE;
+    Scalar mask[P];
+    for (const auto& candidate : classified) {
+        const Obstacle* obstacle = candidate.prepared.obstacle;
+        const Scalar attenuation = static_cast<Scalar>(obstacle->getAttenuation());
+        if (candidate.always) {
+            for (int i = 0; i < P; i++) power[i] -= attenuation;
+        } else {
+            obstacle->blockingMask(xs, ys, candidate.prepared, mask);
+            for (int i = 0; i < P; i++) power[i] -= mask[i] * attenuation;
+        }
+        if (stop && !beats(power, stop)) return; // Ne peut plus que baisser
+    }
+}
+
+/**
+ * subtractObstacles complet, qui retranche aussi les atténuations de geometry (couche d'un
+ * émetteur, en double) et compte les traversées des lanes premières voies (pixel de départ
+ * first, consécutifs) dans crossings[materials[rang de l'obstacle]] si crossings n'est pas vide
+ */
+template <typename Candidates, typename Scalar>
+void subtractObstaclesLayered(const Candidates& classified, const Scalar* xs, const Scalar* ys, Scalar* power,
+                              double* geometry, const std::vector<size_t>& materials,
+                              std::vector<std::vector<uint8_t>>& crossings, size_t first, int lanes) {
+    constexpr int P = Obstacle::PACKET_SIZE;
+    Scalar mask[P];
+    for (const auto& candidate : classified) {
+        const Obstacle* obstacle = candidate.prepared.obstacle;
+        const double attenuation = obstacle->getAttenuation();
+        if (candidate.always) {
+            std::fill(mask, mask + P, static_cast<Scalar>(1));
+        } else {
+            obstacle->blockingMask(xs, ys, candidate.prepared, mask);
+        }
+        for (int i = 0; i < P; i++) power[i] -= mask[i] * static_cast<Scalar>(attenuation);
+        for (int i = 0; i < P; i++) geometry[i] -= mask[i] * attenuation;
+        if (crossings.empty()) continue;
+        uint8_t* counts = crossings[materials[candidate.index]].data() + first;
+        for (int i = 0; i < lanes; i++) {
+            if (mask[i] != 0 && counts[i] < EmitterLayer::CROSSING_SATURATED) counts[i]++;
+        }
+    }
+}
+
+} // namespace
+
+template <typename Scalar>
+void Room::computeExactTilePower(const Tile& tile, bool bounded, double* out, size_t stride, BestServers* servers,
+                                 const std::vector<EmitterLayer*>* layers) const {
+    // Les obstacles ne font que retrancher leur atténuation : la puissance sans obstacles majore
+    // la contribution d'un émetteur (sauf atténuation négative, où rien n'est écarté). Les couches,
+    // recombinées plus tard avec d'autres puissances, sont toutes calculées entièrement
+    bounded = bounded && layers == nullptr;
+
+    // Émetteurs dont la portée atteint la tuile : les autres restent sous le plancher partout
+    const std::vector<size_t> active = emittersInRange(tile, bounded);
+
+    // Moteur exact : obstacles classés une fois par émetteur actif pour toute la tuile
+    std::vector<std::vector<TileObstacle>> classified(active.size());
+    for (size_t a = 0; a < active.size(); a++) classifyObstacles(emitters[active[a]], tile, classified[a]);
+
+    // Paquets de PACKET_SIZE points voisins sur une ligne : chaque obstacle à tester l'est pour
+    // tout le paquet à la fois (blockingMask), le masque multipliant son atténuation
+    constexpr int P = Obstacle::PACKET_SIZE;
+    const PowerKernel powerKernel = selectPowerKernel(model, precision);
+    double xd[P], yd[P], freeSpace[P], geometry[P];
+    Scalar xs[P], ys[P], power[P];
+    std::vector<Scalar> bounds(active.size() * P), best(active.size());
+    std::vector<size_t> order(active.size());
+
+    // K meilleures puissances de chaque voie (top[j·P + i], décroissantes) et leurs émetteurs ;
+    // sans servers, K = 1 : top est le maximum courant
+    const int K = servers ? servers->k : 1;
+    std::vector<Scalar> top(static_cast<size_t>(K) * P);
+    std::vector<uint16_t> who(static_cast<size_t>(K) * P);
+    const Scalar* kth = &top[static_cast<size_t>(K - 1) * P];
+
+    for (int y = tile.y0; y < tile.y1; y++) {
+        double* row = out + static_cast<size_t>(y - tile.y0) * stride;
+        for (int x0 = tile.x0; x0 < tile.x1; x0 += P) {
+            const int lanes = std::min(P, tile.x1 - x0);
+            for (int i = 0; i < P; i++) {
+                xd[i] = x0 + std::min(i, lanes - 1); // Voies en trop : dernier point répété
+                yd[i] = y;
+                xs[i] = static_cast<Scalar>(xd[i]);
+                ys[i] = static_cast<Scalar>(yd[i]);
+            }
+            std::fill(top.begin(), top.end(), static_cast<Scalar>(NOISE_FLOOR));
+            std::fill(who.begin(), who.end(), BestServers::NONE);
+
+            // Séparation et évaluation : émetteurs par puissance sans obstacles décroissante sur
+            // le paquet, un émetteur qui ne peut dépasser le K-ième meilleur courant n'est pas testé
+            for (size_t a = 0; a < active.size(); a++) {
+                powerKernel(model, emitters[active[a]], xd, yd, P, freeSpace);
+                Scalar* bound = &bounds[a * P];
+                for (int i = 0; i < P; i++) bound[i] = static_cast<Scalar>(freeSpace[i]);
+                best[a] = *std::max_element(bound, bound + P);
+                order[a] = a;
+            }
+            if (bounded) std::sort(order.begin(), order.end(), [&](size_t u, size_t v) { return best[u] > best[v]; });
+
+            for (size_t a : order) {
+                const Scalar* bound = &bounds[a * P];
+                if (bounded && !beats(bound, kth)) continue;
+                std::copy(bound, bound + P, power);
+                if (layers) {
+                    // Couche : gain de distance (0 en champ proche) moins les obstacles, comme layerGeometry
+                    const Emitter& emitter = emitters[active[a]];
+                    EmitterLayer& layer = *(*layers)[active[a]];
+                    for (int i = 0; i < P; i++) {
+                        if (!model.distanceGain(emitter.getX(), emitter.getY(), xd[i], yd[i], geometry[i])) geometry[i] = 0.0;
                     }
+                    const size_t first = static_cast<size_t>(y) * width + x0;
+                    subtractObstaclesLayered(classified[a], xs, ys, power, geometry, obstacleMaterials, layer.crossings, first, lanes);
+                    std::copy(geometry, geometry + lanes, layer.geometry.begin() + first);
+                } else {
+                    subtractObstacles(classified[a], xs, ys, power, bounded ? kth : nullptr);
+                }
+                if (K == 1) {
+                    for (int i = 0; i < P; i++) top[i] = std::max(top[i], power[i]);
+                    continue;
+                }
+                // Insertion dans les K meilleurs de chaque voie
+                for (int i = 0; i < P; i++) {
+                    if (!(power[i] > kth[i])) continue;
+                    int j = K - 1;
+                    for (; j > 0 && power[i] > top[(j - 1) * P + i]; j--) {
+                        top[j * P + i] = top[(j - 1) * P + i];
+                        who[j * P + i] = who[(j - 1) * P + i];
+                    }
+                    top[j * P + i] = power[i];
+                    who[j * P + i] = static_cast<uint16_t>(active[a]);
+                }
+            }
+            std::copy(top.begin(), top.begin() + lanes, row + (x0 - tile.x0));
+
+            if (servers) {
+                for (int i = 0; i < lanes; i++) {
+                    const size_t entry = (static_cast<size_t>(y) * width + x0 + i) * K;
+                    for (int j = 0; j < K; j++) {
+                        servers->emitter[entry + j] = who[j * P + i];
+                        servers->power[entry + j] = top[j * P + i];
+                    }
+                }
+            }
+        }
+    }
+}
+
+std::vector<size_t> Room::emittersInRange(const Tile& tile, bool bounded) const {
+    std::vector<size_t> result;
+    for (size_t e = 0; e < emitters.size(); e++) {
+        if (!bounded) {
+            result.push_back(e);
+            continue;
+        }
+        if (tileDistance(tile, emitters[e].getX(), emitters[e].getY()) <= model.range(emitters[e], NOISE_FLOOR)) result.push_back(e);
+    }
+    return result;
+}
+
+double Room::tileDistance(const Tile& tile, double x, double y) {
+    const double dx = std::max({tile.x0 - x, x - (tile.x1 - 1), 0.0});
+    const double dy = std::max({tile.y0 - y, y - (tile.y1 - 1), 0.0});
+    return std::hypot(dx, dy);
+}
+
+void Room::classifyObstacles(const Emitter& emitter, const Tile& tile, std::vector<TileObstacle>& out) const {
+    out.clear();
+    const double ex = emitter.getX(), ey = emitter.getY();
+    // Centres des pixels aux coins de la tuile : leur enveloppe avec l'émetteur contient tous les rayons
+    const double corners[4][2] = {{static_cast<double>(tile.x0), static_cast<double>(tile.y0)},
+                                  {static_cast<double>(tile.x1 - 1), static_cast<double>(tile.y0)},
+                                  {static_cast<double>(tile.x0), static_cast<double>(tile.y1 - 1)},
+                                  {static_cast<double>(tile.x1 - 1), static_cast<double>(tile.y1 - 1)}};
+    // Axes séparateurs candidats : axes de la grille et normales des côtés émetteur -> coin
+    double axes[6][2] = {{1.0, 0.0}, {0.0, 1.0}};
+    int axisCount = 2;
+    for (const auto& c : corners) {
+        if (c[0] != ex || c[1] != ey) {
+            axes[axisCount][0] = ey - c[1];
+            axes[axisCount][1] = c[0] - ex;
+            axisCount++;
+        }
+    }
+    const double margin = 0.01; // Au-delà des tolérances EPSILON de isPointInside / isBlocking
+
+    for (size_t k = 0; k < obstacles.size(); k++) {
+        const Obstacle* obstacle = obstacles[k];
+        double min_x, min_y, max_x, max_y;
+        obstacle->getExpandedBounds(min_x, min_y, max_x, max_y);
+        min_x -= margin; min_y -= margin; max_x += margin; max_y += margin;
+
+        bool separated = false;
+        for (int a = 0; a < axisCount && !separated; a++) {
+            const double nx = axes[a][0], ny = axes[a][1];
+            double lo = ex * nx + ey * ny, hi = lo;
+            for (const auto& c : corners) {
+                const double p = c[0] * nx + c[1] * ny;
+                lo = std::min(lo, p);
+                hi = std::max(hi, p);
+            }
+            const double bx = (nx >= 0 ? min_x : max_x) * nx, Bx = (nx >= 0 ? max_x : min_x) * nx;
+            const double by = (ny >= 0 ? min_y : max_y) * ny, By = (ny >= 0 ? max_y : min_y) * ny;
+            separated = hi < bx + by || lo > Bx + By;
+        }
+        if (separated) continue;
+
+        TileObstacle candidate;
+        candidate.index = k;
+        obstacle->prepare(ex, ey, candidate.prepared);
+        candidate.always = candidate.prepared.emitterInside;
+        if (!candidate.always && dynamic_cast<const MurDroit*>(obstacle) == nullptr) {
+            candidate.always = true;
+            for (const auto& c : corners) {
+                if (!obstacle->isBlocking(c[0], c[1], candidate.prepared)) {
+                    candidate.always = false;
+                    break;
+                }
+            }
+        }
+        out.push_back(candidate);
+    }
+}
+
+std::unique_ptr<OcclusionEngine> Room::prepareEngine() const {
+    switch (engine) {
+        case PropagationEngine::Dda: return std::unique_ptr<OcclusionEngine>(new AttenuationGrid(*this));
+        case PropagationEngine::RayFan: return std::unique_ptr<OcclusionEngine>(new RayFanEngine(*this, threads, engineExactness));
+        case PropagationEngine::Polar: return std::unique_ptr<OcclusionEngine>(new PolarEngine(*this, threads));
+        default: return nullptr;
+    }
+}
+
+std::unique_ptr<OcclusionEngine> Room::prepareEngineGroup(size_t first) const {
+    if (engine != PropagationEngine::Polar) return prepareEngine();
+    return std::unique_ptr<OcclusionEngine>(new PolarEngine(*this, threads, first, PolarEngine::groupEnd(*this, first)));
+}
+
+double Room::computePointPower(int x, int y, const OcclusionEngine* occlusion, std::vector<uint32_t>& scratch) const {
+    if (!occlusion) return computePointPower(x, y);
+    double totalPower = NOISE_FLOOR;
+    for (size_t e = occlusion->firstEmitter; e < std::min(occlusion->endEmitter, emitters.size()); e++) {
+        const double power = model.power(emitters[e], x, y) - occlusion->occlusion(e, x, y, scratch);
+        totalPower = std::max(totalPower, power);
+    }
+    return totalPower;
+}
+
+double Room::computePointPower(int x, int y) const {
+    double totalPower = NOISE_FLOOR;
+    for (const auto& emitter : emitters) {
+        double power = model.power(emitter, x, y);
+        for (const auto& obstacle : obstacles) {
+            if (obstacle->isBlocking(x, y, emitter.getX(), emitter.getY())) {
+                power -= obstacle->getAttenuation();
+            }
+        }
+        totalPower = std::max(totalPower, power);
+    }
+    return totalPower;
+}
+
+std::vector<std::vector<std::vector<double>>> Room::computeMultiFrequencyMaps(const std::vector<double>& frequencies) {
+    std::vector<std::pair<size_t, FrequencyContribution>> contributions;
+    for (size_t e = 0; e < emitters.size(); e++) {
+        for (size_t m = 0; m < frequencies.size(); m++) {
+            const double power = emitters[e].power;
+            contributions.push_back({e, {m, power, frequencies[m], power - Emitter::frequencyLoss(frequencies[m])}});
+        }
+    }
+    return computeSharedGeometryMaps(frequencies.size(), contributions);
+}
+
+std::vector<std::vector<std::vector<double>>> Room::computeBandMaps(std::vector<double>& bands) {
+    bands.clear();
+    for (const auto& emitter : emitters) bands.push_back(emitter.frequency);
+    std::sort(bands.begin(), bands.end());
+    bands.erase(std::unique(bands.begin(), bands.end()), bands.end());
+
+    std::vector<std::pair<size_t, FrequencyContribution>> contributions;
+    for (size_t e = 0; e < emitters.size(); e++) {
+        const Emitter& emitter = emitters[e];
+        const size_t m = std::lower_bound(bands.begin(), bands.end(), emitter.frequency) - bands.begin();
+        contributions.push_back({e, {m, emitter.power, emitter.frequency, emitter.power - Emitter::frequencyLoss(emitter.frequency)}});
+    }
+    return computeSharedGeometryMaps(bands.size(), contributions);
+}
+
+ServingMaps Room::computeServingMaps(double noise, const ThroughputTable* table) const {
+    ServingMaps maps;
+    maps.bestPower.assign(height, std::vector<double>(width, NOISE_FLOOR));
+    maps.bestServer.assign(height, std::vector<int>(width, -1));
+    maps.totalPower.assign(height, std::vector<double>(width, NOISE_FLOOR));
+    maps.interference.assign(height, std::vector<double>(width, NOISE_FLOOR));
+    maps.sinr.assign(height, std::vector<double>(width, NOISE_FLOOR - noise));
+    if (table) {
+        maps.mcs.assign(height, std::vector<int>(width, -1));
+        maps.throughput.assign(height, std::vector<double>(width, 0.0));
+    }
+
+    const std::vector<Tile> grid = tiles();
+    const bool bounded = obstaclesOnlyAttenuate();
+    parallelFor(static_cast<int>(grid.size()), threads, [&](int i) { computeServingTile(grid[i], noise, table, bounded, maps); });
+    return maps;
+}
+
+void Room::computeServingTile(const Tile& tile, double noise, const ThroughputTable* table, bool bounded, ServingMaps& maps) const {
+    const std::vector<size_t> active = emittersInRange(tile, bounded);
+    std::vector<std::vector<TileObstacle>> classified(active.size());
+    for (size_t a = 0; a < active.size(); a++) classifyObstacles(emitters[active[a]], tile, classified[a]);
+
+    // Conversions dB -> mW par paquet (decibelsToMilliwatts) pour chaque émetteur à portée ; le bruit
+    // une fois : 10^(p/10) = exp(p·ln(10)/10)
+    const double dbToNeper = std::log(10.0) / 10;
+    const double noiseMilliwatts = std::exp(noise * dbToNeper);
+
+    constexpr int P = Obstacle::PACKET_SIZE;
+    const PowerKernel powerKernel = selectPowerKernel(model, Precision::Double);
+    double xs[P], ys[P], power[P], milliwatts[P], best[P], bestMilliwatts[P], sum[P], sinr[P], rate[P];
+    int server[P], mcs[P];
+    for (int y = tile.y0; y < tile.y1; y++) {
+        for (int x0 = tile.x0; x0 < tile.x1; x0 += P) {
+            const int lanes = std::min(P, tile.x1 - x0);
+            for (int i = 0; i < P; i++) {
+                xs[i] = x0 + std::min(i, lanes - 1); // Voies en trop : dernier point répété
+                ys[i] = y;
+                best[i] = NOISE_FLOOR;
+                bestMilliwatts[i] = 0.0;
+                sum[i] = 0.0;
+                server[i] = -1;
+            }
+
+            // Chaque émetteur entièrement, cumulé en mW ; le meilleur est retenu comme pour powerMap
+            for (size_t a = 0; a < active.size(); a++) {
+                powerKernel(model, emitters[active[a]], xs, ys, P, power);
+                subtractObstacles(classified[a], xs, ys, power, static_cast<const double*>(nullptr));
+                decibelsToMilliwatts(power, NOISE_FLOOR, milliwatts);
+                for (int i = 0; i < P; i++) {
+                    sum[i] += milliwatts[i];
+                    const bool better = power[i] > best[i];
+                    best[i] = better ? power[i] : best[i];
+                    bestMilliwatts[i] = better ? milliwatts[i] : bestMilliwatts[i];
+                    server[i] = better ? static_cast<int>(active[a]) : server[i];
+                }
+            }
+
+            // Retour en dB scalaire (std::log10 voie par voie) : trois conversions par point, contre une
+            // par émetteur à portée à l'aller ; la version par paquet, vectorisée, rend la passe plus lente
+            for (int i = 0; i < lanes; i++) {
+                const int x = x0 + i;
+                const double others = std::max(0.0, sum[i] - bestMilliwatts[i]);
+                sinr[i] = best[i] - 10 * std::log10(others + noiseMilliwatts);
+                maps.bestPower[y][x] = best[i];
+                maps.bestServer[y][x] = server[i];
+                maps.totalPower[y][x] = sum[i] > 0 ? 10 * std::log10(sum[i]) : NOISE_FLOOR;
+                maps.interference[y][x] = others > 0 ? 10 * std::log10(others) : NOISE_FLOOR;
+                maps.sinr[y][x] = sinr[i];
+            }
+
+            // MCS et débit du paquet, sans repasser sur la carte du SINR
+            if (table) {
+                table->lookup(sinr, lanes, mcs, rate);
+                for (int i = 0; i < lanes; i++) {
+                    const bool served = server[i] >= 0;
+                    maps.mcs[y][x0 + i] = served ? mcs[i] : -1;
+                    maps.throughput[y][x0 + i] = served ? rate[i] : 0.0;
                 }
-                totalPower = std::max(totalPower, power);
             }
-            powerMap[y][x] = totalPower;
         }
     }
 }
 
+std::vector<std::vector<std::vector<double>>> Room::computeSharedGeometryMaps(
+    size_t mapCount, const std::vector<std::pair<size_t, FrequencyContribution>>& contributions) {
+
+    // Regroupement des contributions par position d'émission ; la portée d'une position est celle
+    // de sa contribution la plus forte (chacune évaluée comme un émetteur à sa fréquence)
+    struct Location {
+        size_t emitter; // Un émetteur de la position (classement des obstacles)
+        double x, y;
+        double range;
+        std::vector<FrequencyContribution> contributions;
+    };
+    std::vector<Location> locations;
+    for (const auto& c : contributions) {
+        const Emitter& emitter = emitters[c.first];
+        auto it = std::find_if(locations.begin(), locations.end(), [&](const Location& l) {
+            return l.x == emitter.getX() && l.y == emitter.getY();
+        });
+        if (it == locations.end()) {
+            locations.push_back({c.first, emitter.getX(), emitter.getY(), 0.0, {}});
+            it = locations.end() - 1;
+        }
+        const Emitter evaluated(emitter.getX(), emitter.getY(), c.second.power, c.second.frequency);
+        it->range = std::max(it->range, model.range(evaluated, NOISE_FLOOR));
+        it->contributions.push_back(c.second);
+    }
+
+    std::vector<std::vector<std::vector<double>>> maps(mapCount, std::vector<std::vector<double>>(height, std::vector<double>(width, NOISE_FLOOR)));
+
+    // Même découpage que le moteur exact : par tuile, positions à portée et obstacles classés une
+    // fois ; par paquet, occlusion et gain de distance une fois par position, puis un décalage
+    // par contribution
+    const std::vector<Tile> grid = tiles();
+    const bool bounded = obstaclesOnlyAttenuate();
+    parallelFor(static_cast<int>(grid.size()), threads, [&](int t) {
+        const Tile& tile = grid[t];
+        std::vector<const Location*> active;
+        for (const auto& location : locations) {
+            if (!bounded || tileDistance(tile, location.x, location.y) <= location.range) active.push_back(&location);
+        }
+        std::vector<std::vector<TileObstacle>> classified(active.size());
+        for (size_t a = 0; a < active.size(); a++) classifyObstacles(emitters[active[a]->emitter], tile, classified[a]);
+
+        constexpr int P = Obstacle::PACKET_SIZE;
+        double xs[P], ys[P], occlusion[P], gain[P];
+        bool farField[P];
+        for (int y = tile.y0; y < tile.y1; y++) {
+            for (int x0 = tile.x0; x0 < tile.x1; x0 += P) {
+                const int lanes = std::min(P, tile.x1 - x0);
+                for (int i = 0; i < P; i++) {
+                    xs[i] = x0 + std::min(i, lanes - 1); // Voies en trop : dernier point répété
+                    ys[i] = y;
+                }
+                for (size_t a = 0; a < active.size(); a++) {
+                    // Partie indépendante de la fréquence : occlusion (négative) et gain de distance
+                    const Location& location = *active[a];
+                    std::fill(occlusion, occlusion + P, 0.0);
+                    subtractObstacles(classified[a], xs, ys, occlusion, static_cast<const double*>(nullptr));
+                    for (int i = 0; i < lanes; i++) farField[i] = model.distanceGain(location.x, location.y, xs[i], ys[i], gain[i]);
+
+                    for (const auto& c : location.contributions) {
+                        double* cells = maps[c.map][y].data() + x0;
+                        for (int i = 0; i < lanes; i++) {
+                            const double power = (farField[i] ? c.offset + gain[i] : c.power) + occlusion[i];
+                            cells[i] = std::max(cells[i], power);
+                        }
+                    }
+                }
+            }
+        }
+    });
+    return maps;
+}
+
+std::vector<size_t> Room::nearFieldPixels(const Emitter& emitter) const {
+    std::vector<size_t> result;
+    const int cx = static_cast<int>(std::lround(emitter.getX()));
+    const int cy = static_cast<int>(std::lround(emitter.getY()));
+    const int reach = 1 + static_cast<int>(0.001 * model.resolution); // 1 mm en pixels, arrondi au-dessus
+    double gain;
+    for (int y = std::max(0, cy - reach); y <= std::min(height - 1, cy + reach); y++) {
+        for (int x = std::max(0, cx - reach); x <= std::min(width - 1, cx + reach); x++) {
+            if (!model.distanceGain(emitter.getX(), emitter.getY(), x, y, gain)) {
+                result.push_back(static_cast<size_t>(y) * width + x);
+            }
+        }
+    }
+    return result;
+}
+
+double Room::layerGeometry(const Emitter& emitter, int x, int y, EmitterLayer* layer) const {
+    const bool counting = keepCrossingCounts && layer != nullptr && !layer->crossings.empty();
+    const size_t pixel = static_cast<size_t>(y) * width + x;
+
+    double geometry = 0.0;
+    model.distanceGain(emitter.getX(), emitter.getY(), x, y, geometry);
+    for (size_t k = 0; k < obstacles.size(); k++) {
+        if (obstacles[k]->isBlocking(x, y, emitter.getX(), emitter.getY())) {
+            geometry -= obstacles[k]->getAttenuation();
+            if (counting) {
+                uint8_t& count = layer->crossings[obstacleMaterials[k]][pixel];
+                if (count < EmitterLayer::CROSSING_SATURATED) count++;
+            }
+        }
+    }
+    return geometry;
+}
+
+void Room::indexMaterials() {
+    obstacleMaterials.clear();
+    for (const auto& obstacle : obstacles) {
+        auto it = std::find(materials.begin(), materials.end(), obstacle->getAttenuation());
+        obstacleMaterials.push_back(it - materials.begin());
+        if (it == materials.end()) materials.push_back(obstacle->getAttenuation());
+    }
+    for (size_t e = 0; e < emitterLayers.size(); e++) {
+        const EmitterLayer& layer = *emitterLayers[e];
+        if (!layer.crossings.empty() && layer.crossings.size() < materials.size()) {
+            writableLayer(e).crossings.resize(materials.size(), std::vector<uint8_t>(static_cast<size_t>(width) * height, 0));
+        }
+    }
+}
+
+EmitterLayer& Room::writableLayer(size_t index) {
+    std::shared_ptr<const EmitterLayer>& layer = emitterLayers[index];
+    // Les couches sont toujours créées modifiables (make_shared<EmitterLayer>) : le const_cast
+    // ne sert qu'à la couche dont cette salle est la seule propriétaire
+    if (layer.use_count() > 1) layer = std::make_shared<EmitterLayer>(*layer);
+    return const_cast<EmitterLayer&>(*layer);
+}
+
+void Room::computeEmitterLayer(size_t index) {
+    bestServers = BestServers(); // Émetteur déplacé ou ajouté
+    while (emitterLayers.size() < emitters.size()) emitterLayers.push_back(std::make_shared<EmitterLayer>());
+    const Emitter& emitter = emitters[index];
+    // Couche neuve, publiée à la fin : l'ancienne reste aux copies de la salle qui la partagent
+    auto computed = std::make_shared<EmitterLayer>();
+    EmitterLayer& layer = *computed;
+    layer.geometry.resize(static_cast<size_t>(width) * height);
+    layer.nearField = nearFieldPixels(emitter);
+    if (keepCrossingCounts) {
+        indexMaterials();
+        layer.crossings.assign(materials.size(), std::vector<uint8_t>(static_cast<size_t>(width) * height, 0));
+    }
+
+    const std::vector<Tile> grid = tiles();
+    parallelFor(static_cast<int>(grid.size()), threads, [&](int i) { computeLayerTile(grid[i], emitter, layer); });
+    emitterLayers[index] = computed;
+}
+
+void Room::computeLayerTile(const Tile& tile, const Emitter& emitter, EmitterLayer& layer) const {
+    // Même noyau que les couches de computeExactTilePower, pour un seul émetteur (en double)
+    std::vector<TileObstacle> classified;
+    classifyObstacles(emitter, tile, classified);
+
+    constexpr int P = Obstacle::PACKET_SIZE;
+    double xs[P], ys[P], power[P], geometry[P];
+    for (int y = tile.y0; y < tile.y1; y++) {
+        for (int x0 = tile.x0; x0 < tile.x1; x0 += P) {
+            const int lanes = std::min(P, tile.x1 - x0);
+            for (int i = 0; i < P; i++) {
+                xs[i] = x0 + std::min(i, lanes - 1); // Voies en trop : dernier point répété
+                ys[i] = y;
+                if (!model.distanceGain(emitter.getX(), emitter.getY(), xs[i], ys[i], geometry[i])) geometry[i] = 0.0;
+                power[i] = geometry[i];
+            }
+            const size_t first = static_cast<size_t>(y) * width + x0;
+            subtractObstaclesLayered(classified, xs, ys, power, geometry, obstacleMaterials, layer.crossings, first, lanes);
+            std::copy(geometry, geometry + lanes, layer.geometry.begin() + first);
+        }
+    }
+}
+
+void Room::applyObstacleToLayers(const Obstacle* obstacle, double sign) {
+    bestServers = BestServers();
+    const double attenuation = sign * obstacle->getAttenuation();
+    if (keepCrossingCounts) indexMaterials();
+    const size_t material = std::find(materials.begin(), materials.end(), obstacle->getAttenuation()) - materials.begin();
+    const std::vector<Tile> grid = tiles();
+    std::vector<std::vector<size_t>> shadow(grid.size());
+    for (size_t e = 0; e < emitterLayers.size() && e < emitters.size(); e++) {
+        // Points masqués, tuile par tuile : une couche sans point masqué n'est ni modifiée ni copiée
+        const Emitter& emitter = emitters[e];
+        PreparedObstacle prepared;
+        obstacle->prepare(emitter.getX(), emitter.getY(), prepared);
+        parallelFor(static_cast<int>(grid.size()), threads, [&](int i) {
+            const Tile& tile = grid[i];
+            shadow[i].clear();
+            for (int y = tile.y0; y < tile.y1; y++) {
+                for (int x = tile.x0; x < tile.x1; x++) {
+                    if (obstacle->isBlocking(x, y, prepared)) shadow[i].push_back(static_cast<size_t>(y) * width + x);
+                }
+            }
+        });
+        if (std::all_of(shadow.begin(), shadow.end(), [](const std::vector<size_t>& s) { return s.empty(); })) continue;
+
+        EmitterLayer& layer = writableLayer(e);
+        double* geometry = layer.geometry.data();
+        uint8_t* counts = material < layer.crossings.size() ? layer.crossings[material].data() : nullptr;
+        parallelFor(static_cast<int>(grid.size()), threads, [&](int i) {
+            for (size_t pixel : shadow[i]) {
+                geometry[pixel] -= attenuation;
+                // Un compte saturé reste saturé : le point sera recalculé exactement
+                if (counts && counts[pixel] != EmitterLayer::CROSSING_SATURATED) {
+                    counts[pixel] = static_cast<uint8_t>(counts[pixel] + (sign > 0 ? 1 : -1));
+                }
+            }
+        });
+    }
+}
+
+bool Room::setMaterialAttenuation(double oldAttenuation, double newAttenuation) {
+    bool found = false;
+    for (auto* obstacle : obstacles) {
+        if (obstacle->getAttenuation() == oldAttenuation) {
+            obstacle->setAttenuation(newAttenuation);
+            found = true;
+        }
+    }
+    if (!found) return false;
+    bestServers = BestServers(); // Rempli à nouveau si la carte est recalculée
+
+    const bool layersComplete = emitterLayers.size() == emitters.size();
+    bool countsComplete = layersComplete && keepCrossingCounts;
+    for (const auto& layer : emitterLayers) {
+        countsComplete = countsComplete && layer->crossings.size() == materials.size();
+    }
+    auto it = std::find(materials.begin(), materials.end(), oldAttenuation);
+
+    if (!countsComplete || it == materials.end()) {
+        // Pas de traversées enregistrées : recalcul des couches (ou de la carte)
+        if (!layersComplete) {
+            computeSignalMap();
+            return true;
+        }
+        for (size_t e = 0; e < emitters.size(); e++) computeEmitterLayer(e);
+        combineEmitterLayers();
+        return true;
+    }
+
+    // Re-sommation : geometry -= delta * nombre de traversées du matériau
+    const size_t material = it - materials.begin();
+    const double delta = newAttenuation - oldAttenuation;
+    for (size_t e = 0; e < emitterLayers.size(); e++) {
+        EmitterLayer& layer = writableLayer(e);
+        const uint8_t* counts = layer.crossings[material].data();
+        double* geometry = layer.geometry.data();
+        parallelFor(height, threads, [&](int y) {
+            const size_t start = static_cast<size_t>(y) * width, end = start + width;
+            for (size_t i = start; i < end; i++) {
+                geometry[i] -= delta * counts[i];
+            }
+            // Points saturés : recalcul exact
+            for (size_t i = start; i < end; i++) {
+                if (counts[i] == EmitterLayer::CROSSING_SATURATED) {
+                    geometry[i] = layerGeometry(emitters[e], static_cast<int>(i - start), y, nullptr);
+                }
+            }
+        });
+    }
+
+    // Le matériau prend sa nouvelle valeur, fusionné avec un matériau existant de même atténuation
+    auto target = std::find(materials.begin(), materials.end(), newAttenuation);
+    if (target != materials.end()) {
+        const size_t merged = target - materials.begin();
+        for (size_t e = 0; e < emitterLayers.size(); e++) {
+            EmitterLayer& layer = writableLayer(e);
+            auto& into = layer.crossings[merged];
+            const auto& from = layer.crossings[material];
+            for (size_t i = 0; i < into.size(); i++) {
+                into[i] = static_cast<uint8_t>(std::min<int>(into[i] + from[i], EmitterLayer::CROSSING_SATURATED));
+            }
+            layer.crossings.erase(layer.crossings.begin() + material);
+        }
+        materials.erase(materials.begin() + material);
+    } else {
+        materials[material] = newAttenuation;
+    }
+    indexMaterials();
+
+    combineEmitterLayers();
+    return true;
+}
+
+void Room::combineEmitterLayers() {
+    bestServers = BestServers(); // La carte ne vient plus du calcul qui l'a rempli
+    const size_t layerCount = std::min(emitterLayers.size(), emitters.size());
+    std::vector<double> offsets(layerCount);
+    for (size_t e = 0; e < layerCount; e++) offsets[e] = layerOffset(e);
+
+    // Maximum des couches décalées, une ligne contiguë à la fois
+    parallelFor(height, threads, [&](int y) {
+        std::vector<double> buffer(quantized ? width : 0); // Ligne en doubles avant quantification
+        double* row = quantized ? buffer.data() : powerMap[y].data();
+        std::fill(row, row + width, NOISE_FLOOR);
+        for (size_t e = 0; e < layerCount; e++) {
+            const double* geometry = emitterLayers[e]->geometry.data() + static_cast<size_t>(y) * width;
+            const double offset = offsets[e];
+            for (int x = 0; x < width; x++) {
+                row[x] = std::max(row[x], offset + geometry[x]);
+            }
+        }
+        if (quantized) {
+            int16_t* out = quantizedMap.data() + static_cast<size_t>(y) * width;
+            for (int x = 0; x < width; x++) out[x] = QuantizedPower::encode(row[x]);
+        }
+    });
+
+    // Points en champ proche : la puissance émise remplace le décalage
+    for (size_t e = 0; e < layerCount; e++) {
+        for (size_t i : emitterLayers[e]->nearField) {
+            double totalPower = NOISE_FLOOR;
+            for (size_t k = 0; k < layerCount; k++) totalPower = std::max(totalPower, layerPower(k, i, offsets[k]));
+            setPower(static_cast<int>(i % width), static_cast<int>(i / width), totalPower);
+        }
+    }
+}
+
+double Room::layerOffset(size_t emitter) const {
+    return emitters[emitter].power - Emitter::frequencyLoss(emitters[emitter].frequency);
+}
+
+double Room::layerPower(size_t emitter, size_t pixel, double offset) const {
+    const EmitterLayer& layer = *emitterLayers[emitter];
+    const bool near = std::find(layer.nearField.begin(), layer.nearField.end(), pixel) != layer.nearField.end();
+    return (near ? emitters[emitter].power : offset) + layer.geometry[pixel];
+}
+
+void Room::setEmitterPower(size_t index, double power) {
+    emitters[index].power = power;
+    bestServers = BestServers(); // Rempli à nouveau par computeSignalMap si keepBestServers
+    if (emitterLayers.size() == emitters.size()) combineEmitterLayers();
+    else computeSignalMap();
+}
+
+void Room::setEmitterFrequency(size_t index, double frequency) {
+    emitters[index].frequency = frequency;
+    bestServers = BestServers(); // Rempli à nouveau par computeSignalMap si keepBestServers
+    if (emitterLayers.size() == emitters.size()) combineEmitterLayers();
+    else computeSignalMap();
+}
+
 void Room::markObstaclesOnPowerMap() {
     for (const auto& obstacle : obstacles) {
         double min_x, min_y, max_x, max_y;
@@ -45,7 +968,7 @@ void Room::markObstaclesOnPowerMap() {
         for (int y = start_y; y <= end_y; y++) {
             for (int x = start_x; x <= end_x; x++) {
                 if (obstacle->isPointInside(x, y)) { // Vérification précise
-                    powerMap[y][x] = -555; // Marquage spécial
+                    setPower(x, y, -555); // Marquage spécial
                 }
             }
         }
@@ -55,39 +978,266 @@ void Room::markObstaclesOnPowerMap() {
     markRoomBoundaries();
 }
 
+std::vector<const Obstacle*> Room::obstaclesTouching(const Tile& tile) const {
+    std::vector<const Obstacle*> result;
+    for (const Obstacle* obstacle : obstacles) {
+        double min_x, min_y, max_x, max_y;
+        obstacle->getExpandedBounds(min_x, min_y, max_x, max_y);
+        // Mêmes arrondis que markObstaclesOnPowerMap
+        if (std::ceil(max_x) >= tile.x0 && std::floor(min_x) < tile.x1 &&
+            std::ceil(max_y) >= tile.y0 && std::floor(min_y) < tile.y1) {
+            result.push_back(obstacle);
+        }
+    }
+    return result;
+}
+
+bool Room::isMarkedAsObstacle(int x, int y, const std::vector<const Obstacle*>& candidates) const {
+    if (x < BOUNDARY_MARGIN || y < BOUNDARY_MARGIN || x >= width - BOUNDARY_MARGIN || y >= height - BOUNDARY_MARGIN) {
+        return true; // markRoomBoundaries
+    }
+    for (const Obstacle* obstacle : candidates) {
+        if (obstacle->isPointInside(x, y)) return true;
+    }
+    return false;
+}
+
+std::vector<size_t> Room::samplePoints(int step) const {
+    const std::vector<const Obstacle*> all(obstacles.begin(), obstacles.end());
+    std::vector<size_t> samples;
+    for (int y = BOUNDARY_MARGIN; y < height - BOUNDARY_MARGIN; y += step) {
+        for (int x = BOUNDARY_MARGIN; x < width - BOUNDARY_MARGIN; x += step) {
+            if (!isMarkedAsObstacle(x, y, all)) samples.push_back(static_cast<size_t>(y) * width + x);
+        }
+    }
+    return samples;
+}
+
 /**
  * Exporte la carte de puissance au format CSV
  * @param filename Nom du fichier de sortie
  */
 void Room::exportToCSV(const std::string& filename) {
-    std::ofstream file(filename);
+    exportMapToCSV(*mapReader(), filename);
+}
+
+namespace {
+    const char BINARY_MAGIC[4] = {'P', 'M', 'A', 'P'};
+    const uint32_t BINARY_VERSION = 2;
+}
+
+bool Room::exportToBinary(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary);
     if (!file) {
         std::cerr << "Erreur d'ouverture du fichier !" << std::endl;
-        return;
+        return false;
+    }
+
+    const int32_t w = width, h = height;
+    const uint32_t layers = 1 + static_cast<uint32_t>(emitterLayers.size());
+    const uint64_t hash = sceneHash();
+    file.write(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    file.write(reinterpret_cast<const char*>(&BINARY_VERSION), sizeof(BINARY_VERSION));
+    file.write(reinterpret_cast<const char*>(&w), sizeof(w));
+    file.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    file.write(reinterpret_cast<const char*>(&layers), sizeof(layers));
+    file.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+
+    // Carte principale (toujours en doubles) puis couches par émetteur, en blocs contigus
+    std::unique_ptr<PowerMapReader> reader = mapReader();
+    std::vector<double> row(width);
+    for (int y = 0; y < height; y++) {
+        reader->readRow(y, 0, width, row.data());
+        file.write(reinterpret_cast<const char*>(row.data()), row.size() * sizeof(double));
+    }
+    for (const auto& layer : emitterLayers) {
+        file.write(reinterpret_cast<const char*>(layer->geometry.data()), layer->geometry.size() * sizeof(double));
+    }
+    return static_cast<bool>(file);
+}
+
+bool Room::loadFromBinary(const std::string& filename, uint64_t expectedHash) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) return false;
+
+    char magic[4];
+    uint32_t version = 0, layers = 0;
+    int32_t w = 0, h = 0;
+    uint64_t hash = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&w), sizeof(w));
+    file.read(reinterpret_cast<char*>(&h), sizeof(h));
+    file.read(reinterpret_cast<char*>(&layers), sizeof(layers));
+    file.read(reinterpret_cast<char*>(&hash), sizeof(hash));
+
+    if (!file || std::memcmp(magic, BINARY_MAGIC, sizeof(magic)) != 0 || version != BINARY_VERSION) {
+        std::cerr << "Fichier binaire invalide: " << filename << std::endl;
+        return false;
+    }
+    if (w != width || h != height || layers == 0 || (expectedHash != 0 && hash != expectedHash)) {
+        return false; // Carte d'une autre scène
     }
 
-    // Écriture ligne par ligne
-    for (const auto& row : powerMap) {
-        for (size_t i = 0; i < row.size(); i++) {
-            file << row[i];
-            if (i < row.size() - 1) file << ",";
+    std::vector<std::vector<double>> map(height, std::vector<double>(width));
+    for (auto& row : map) {
+        file.read(reinterpret_cast<char*>(row.data()), row.size() * sizeof(double));
+    }
+    std::vector<std::shared_ptr<const EmitterLayer>> layersData;
+    for (size_t e = 0; e + 1 < layers; e++) {
+        auto layer = std::make_shared<EmitterLayer>();
+        layer->geometry.resize(static_cast<size_t>(width) * height);
+        file.read(reinterpret_cast<char*>(layer->geometry.data()), layer->geometry.size() * sizeof(double));
+        // Les points en champ proche se déduisent de la position des émetteurs
+        if (e < emitters.size()) layer->nearField = nearFieldPixels(emitters[e]);
+        layersData.push_back(layer);
+    }
+    if (!file) {
+        std::cerr << "Fichier binaire tronque: " << filename << std::endl;
+        return false;
+    }
+    if (quantized) {
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) setPower(x, y, map[y][x]);
         }
-        file << "\n";
+    } else {
+        powerMap = std::move(map);
+    }
+    emitterLayers = std::move(layersData);
+    bestServers = BestServers(); // Non enregistré avec la carte
+    return true;
+}
+
+void Room::describe(std::ostream& os) const {
+    // Précision maximale : deux scènes qui diffèrent d'un bit n'ont pas la même description
+    const auto oldPrecision = os.precision(17);
+    os << "ROOM " << width << " " << height << "\n";
+    os << "RESOLUTION " << model.resolution << "\n";
+    os << "MODEL " << PROPAGATION_MODEL_VERSION << "\n";
+    if (model.pathLoss == PathLoss::LogDistance) os << "PATHLOSS logdistance " << model.exponent << "\n";
+    if (model.pathLoss == PathLoss::DualSlope) {
+        os << "PATHLOSS dualslope " << model.exponent << " " << model.breakpoint << " " << model.farExponent << "\n";
+    }
+    if (precision != Precision::Double) os << "PRECISION " << precisionName(precision) << "\n";
+    // Moteur : cartes différentes ; mode exact : même carte, mais un calcul en cache ne serait pas vérifié.
+    // Couches gardées : carte calculée par le moteur exact (computeSignalMap), quel que soit engine
+    if (engine != PropagationEngine::Exact && !keepEmitterLayers) os << "ENGINE " << engineName(engine) << (engineExactness ? " exact" : "") << "\n";
+    for (const auto& emitter : emitters) {
+        os << "EMITTER " << emitter.x << " " << emitter.y << " " << emitter.power << " " << emitter.frequency << "\n";
+    }
+    for (const auto& obstacle : obstacles) {
+        obstacle->describe(os);
+        os << "\n";
+    }
+    os.precision(oldPrecision);
+}
+
+uint64_t Room::sceneHash() const {
+    std::ostringstream description;
+    describe(description);
+
+    // FNV-1a 64 bits
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : description.str()) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
     }
-    file.close();
-    std::cout << "Carte exportée vers " << filename << std::endl;
+    return hash;
 }
 
 bool Room::deleteEmitter(double x, double y) {
     for (auto it = emitters.begin(); it != emitters.end(); ++it) {
         if (it->getX() == x && it->getY() == y) {
+            const uint16_t removed = static_cast<uint16_t>(it - emitters.begin());
+            // Couches alignées sur emitters : celle de l'émetteur part avec lui
+            if (removed < emitterLayers.size()) emitterLayers.erase(emitterLayers.begin() + removed);
             emitters.erase(it);
+            removeFromBestServers(removed);
             return true; // Émetteur supprimé
         }
     }
     return false; // Émetteur non trouvé
 }
 
+void Room::removeFromBestServers(uint16_t removed) {
+    const int K = bestServers.k;
+    const size_t pixels = static_cast<size_t>(width) * height;
+    if (K < 2 || bestServers.emitter.size() != pixels * K || !hasPowerMap()) {
+        bestServers = BestServers(); // Plus à jour
+        return;
+    }
+
+    // Chaque point garde ses K - 1 meilleurs restants (indices décalés comme emitters), la carte
+    // prend le nouveau meilleur ; compactage en place, point par point dans l'ordre
+    const int kept = K - 1;
+    for (size_t p = 0; p < pixels; p++) {
+        uint16_t emitter[BestServers::MAX_K];
+        double power[BestServers::MAX_K];
+        int n = 0;
+        for (int j = 0; j < K && n < kept; j++) {
+            const uint16_t e = bestServers.emitter[p * K + j];
+            if (e == removed) continue;
+            emitter[n] = e == BestServers::NONE || e < removed ? e : static_cast<uint16_t>(e - 1);
+            power[n] = bestServers.power[p * K + j];
+            n++;
+        }
+        for (int j = 0; j < kept; j++) {
+            bestServers.emitter[p * kept + j] = emitter[j];
+            bestServers.power[p * kept + j] = power[j];
+        }
+
+        const int x = static_cast<int>(p % width), y = static_cast<int>(p / width);
+        if (getPower(x, y) != -555) setPower(x, y, power[0]); // Obstacles marqués conservés
+    }
+    bestServers.k = kept;
+    bestServers.emitter.resize(pixels * kept);
+    bestServers.power.resize(pixels * kept);
+}
+
+std::vector<double> Room::singleFailureCoverage(double threshold) const {
+    const int K = bestServers.k;
+    const size_t pixels = static_cast<size_t>(width) * height;
+    if (K < 2 || bestServers.emitter.size() != pixels * K) return {};
+
+    // Un point ne dépend que de son meilleur émetteur : sans lui, c'est le second qui le sert.
+    // Points marqués (bords, intérieur des obstacles) exclus, comme pour coverageStatisticsFromMap
+    struct Counts {
+        long points = 0, covered = 0;
+        std::vector<long> lost;
+    };
+    const std::vector<Tile> grid = tiles();
+    std::vector<Counts> partial(grid.size());
+    parallelFor(static_cast<int>(grid.size()), threads, [&](int i) {
+        const Tile& tile = grid[i];
+        const std::vector<const Obstacle*> nearby = obstaclesTouching(tile);
+        Counts& counts = partial[i];
+        counts.lost.assign(emitters.size(), 0);
+        for (int y = tile.y0; y < tile.y1; y++) {
+            for (int x = tile.x0; x < tile.x1; x++) {
+                if (isMarkedAsObstacle(x, y, nearby)) continue;
+                counts.points++;
+                const size_t p = static_cast<size_t>(y) * width + x;
+                if (bestServers.power[p * K] < threshold) continue;
+                counts.covered++;
+                if (bestServers.power[p * K + 1] < threshold) counts.lost[bestServers.emitter[p * K]]++;
+            }
+        }
+    });
+
+    long points = 0, covered = 0;
+    std::vector<long> lost(emitters.size(), 0);
+    for (const Counts& counts : partial) {
+        points += counts.points;
+        covered += counts.covered;
+        for (size_t e = 0; e < emitters.size(); e++) lost[e] += counts.lost[e];
+    }
+
+    std::vector<double> result(emitters.size(), 0.0);
+    if (points == 0) return result;
+    for (size_t e = 0; e < emitters.size(); e++) result[e] = 100.0 * (covered - lost[e]) / points;
+    return result;
+}
+
 bool Room::deleteObstacle(double x1, double y1, double x2, double y2) {
     for (auto it = obstacles.begin(); it != obstacles.end(); ++it) {
         // Vérifier si l'obstacle est un Mur en utilisant le cast dynamique
@@ -99,8 +1249,12 @@ bool Room::deleteObstacle(double x1, double y1, double x2, double y2) {
             std::abs(mur->getY1() - y1) < 0.001 && 
             std::abs(mur->getX2() - x2) < 0.001 && 
             std::abs(mur->getY2() - y2) < 0.001) {
-            
+
+            // Atténuation retirée des couches (points masqués par l'obstacle seulement)
+            if (!emitterLayers.empty()) applyObstacleToLayers(*it, -1.0);
             obstacles.erase(it);
+            if (keepCrossingCounts) indexMaterials(); // obstacleMaterials reste aligné sur obstacles
+            bestServers = BestServers();
             return true; // Obstacle supprimé
         }
     }
@@ -110,22 +1264,22 @@ bool Room::deleteObstacle(double x1, double y1, double x2, double y2) {
 void Room::markRoomBoundaries() {
     // Bords verticaux
     for (int y = 0; y < height; y++) {
-        powerMap[y][0] = -555;        // Bord gauche
-        powerMap[y][1] = -555;        // Zone de sécurité
-        powerMap[y][2] = -555;        // Zone de sécurité
-        powerMap[y][width-1] = -555;  // Bord droit
-        powerMap[y][width-2] = -555;  // Zone de sécurité
-        powerMap[y][width-3] = -555;  // Zone de sécurité
+        setPower(0, y, -555);        // Bord gauche
+        setPower(1, y, -555);        // Zone de sécurité
+        setPower(2, y, -555);        // Zone de sécurité
+        setPower(width-1, y, -555);  // Bord droit
+        setPower(width-2, y, -555);  // Zone de sécurité
+        setPower(width-3, y, -555);  // Zone de sécurité
 
     }
 
     // Bords horizontaux
     for (int x = 0; x < width; x++) {
-        powerMap[0][x] = -555;        // Bord supérieur
-        powerMap[1][x] = -555;        // Zone de sécurité
-        powerMap[2][x] = -555;        // Zone de sécurité
-        powerMap[height-1][x] = -555; // Bord inférieur
-        powerMap[height-2][x] = -555;  // Zone de sécurité
-        powerMap[height-3][x] = -555;  // Zone de sécurité
+        setPower(x, 0, -555);        // Bord supérieur
+        setPower(x, 1, -555);        // Zone de sécurité
+        setPower(x, 2, -555);        // Zone de sécurité
+        setPower(x, height-1, -555); // Bord inférieur
+        setPower(x, height-2, -555);  // Zone de sécurité
+        setPower(x, height-3, -555);  // Zone de sécurité
     }
 }
@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <filesystem>
+
+#include "../headers/scene.hpp"
+#include "../headers/floorplan.hpp"
+
+Room* loadScene(const std::string& filename, bool allocateMap) {
+    std::ifstream file(filename);
+    if (!file) {
+        std::cerr << "Impossible d'ouvrir le fichier: " << filename << std::endl;
+        return nullptr;
+    }
+
+    Room* room = nullptr;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        std::istringstream in(line);
+        std::string keyword;
+        if (!(in >> keyword) || keyword[0] == '#') continue;
+
+        bool ok = true;
+        if (keyword == "ROOM") {
+            int w, h;
+            ok = !room && static_cast<bool>(in >> w >> h) && w > 6 && h > 6;
+            if (ok) room = new Room(w, h, allocateMap);
+        }
+        else if (!room) {
+            ok = false;
+        }
+        else if (keyword == "EMITTER") {
+            double x, y, power, frequency;
+            ok = static_cast<bool>(in >> x >> y >> power >> frequency);
+            if (ok) room->addEmitter(Emitter(x, y, power, frequency));
+        }
+        else if (keyword == "MUR" || keyword == "MURDROIT" || keyword == "CERCLE") {
+            Obstacle* obstacle = parseObstacle(line);
+            ok = obstacle != nullptr;
+            if (ok) room->addObstacle(obstacle);
+        }
+        else if (keyword == "FLOORPLAN") {
+            std::string plan, word;
+            FloorplanImportOptions options;
+            ok = static_cast<bool>(in >> plan);
+            // Axe Y vers le haut des DXF : inversé par défaut, sauf NOFLIPY
+            std::filesystem::path path(plan);
+            std::string extension = path.extension().string();
+            std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return std::tolower(c); });
+            options.flipY = extension == ".dxf";
+            // Nombres dans l'ordre (échelle, atténuation, épaisseur), puis FLIPY ou NOFLIPY
+            double* numbers[] = {&options.scale, &options.attenuation, &options.thickness};
+            size_t count = 0;
+            bool flag = false;
+            while (ok && in >> word) {
+                if (word == "FLIPY" || word == "NOFLIPY") {
+                    ok = !flag;
+                    flag = true;
+                    options.flipY = word == "FLIPY";
+                    continue;
+                }
+                std::istringstream number(word);
+                ok = !flag && count < 3 && static_cast<bool>(number >> *numbers[count]) && number.eof();
+                count++;
+            }
+            // Plan inversé : origine du fichier en bas à gauche de la salle
+            if (options.flipY) options.offsetY = room->height;
+            if (ok) {
+                // Chemin relatif au fichier de scène
+                if (path.is_relative()) path = std::filesystem::path(filename).parent_path() / path;
+                // Plan absent, de format inconnu ou illisible : la scène sans ses murs serait fausse
+                ok = importFloorplan(*room, path.string(), options).segmentsRead > 0;
+            }
+        }
+        else if (keyword == "RESOLUTION") {
+            ok = static_cast<bool>(in >> room->model.resolution) && room->model.isValid();
+        }
+        else if (keyword == "PRECISION") {
+            std::string name;
+            ok = static_cast<bool>(in >> name) && parsePrecision(name, room->precision);
+        }
+        else if (keyword == "PATHLOSS") {
+            std::string name;
+            PropagationModel& model = room->model;
+            ok = static_cast<bool>(in >> name) && parsePathLoss(name, model.pathLoss);
+            if (ok && model.pathLoss == PathLoss::LogDistance) ok = static_cast<bool>(in >> model.exponent);
+            if (ok && model.pathLoss == PathLoss::DualSlope) {
+                ok = static_cast<bool>(in >> model.exponent >> model.breakpoint >> model.farExponent);
+            }
+            ok = ok && model.isValid();
+        }
+        else if (keyword == "ENGINE") {
+            std::string name, mode;
+            ok = static_cast<bool>(in >> name) && parseEngine(name, room->engine);
+            // Mode exact, propre au moteur rayfan
+            if (ok && in >> mode) ok = mode == "exact" && room->engine == PropagationEngine::RayFan;
+            room->engineExactness = ok && !mode.empty();
+        }
+        else if (keyword != "MODEL") {
+            ok = false;
+        }
+
+        if (!ok) {
+            std::cerr << filename << ":" << lineNumber << ": ligne invalide: " << line << std::endl;
+            deleteScene(room);
+            return nullptr;
+        }
+    }
+
+    if (!room) {
+        std::cerr << filename << ": declaration ROOM manquante" << std::endl;
+    }
+    return room;
+}
+
+Obstacle* parseObstacle(const std::string& line) {
+    std::istringstream in(line);
+    std::string keyword;
+    in >> keyword;
+
+    if (keyword == "MUR" || keyword == "MURDROIT") {
+        double x1, y1, x2, y2, thickness, attenuation;
+        if (!(in >> x1 >> y1 >> x2 >> y2 >> thickness >> attenuation)) return nullptr;
+        if (keyword == "MUR") return new Mur(x1, y1, x2, y2, thickness, attenuation);
+        MurDroit* mur = new MurDroit(x1, y1, x2, y2, thickness, attenuation);
+        if (mur->getOrientation() == MurDroit::OBLIQUE) {
+            std::cerr << "MURDROIT ni vertical ni horizontal, traite comme un MUR: " << line << std::endl;
+        }
+        return mur;
+    }
+    if (keyword == "CERCLE") {
+        double cx, cy, radius, attenuation;
+        if (!(in >> cx >> cy >> radius >> attenuation)) return nullptr;
+        return new obstacleCirculaire(cx, cy, radius, attenuation);
+    }
+    return nullptr;
+}
+
+bool saveScene(const Room& room, const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file) {
+        std::cerr << "Erreur d'ouverture du fichier !" << std::endl;
+        return false;
+    }
+    room.describe(file);
+    return static_cast<bool>(file);
+}
+
+void deleteScene(Room* room) {
+    if (!room) return;
+    for (auto* obstacle : room->obstacles) delete obstacle;
+    delete room;
+}
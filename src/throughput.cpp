@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "../headers/throughput.hpp"
+
+ThroughputTable::ThroughputTable() {
+    setEntries({
+        {0, 5.0, 6.5},   // BPSK 1/2
+        {1, 8.0, 13.0},  // QPSK 1/2
+        {2, 11.0, 19.5}, // QPSK 3/4
+        {3, 14.0, 26.0}, // 16-QAM 1/2
+        {4, 17.0, 39.0}, // 16-QAM 3/4
+        {5, 21.0, 52.0}, // 64-QAM 2/3
+        {6, 23.0, 58.5}, // 64-QAM 3/4
+        {7, 25.0, 65.0}  // 64-QAM 5/6
+    });
+}
+
+bool ThroughputTable::load(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Impossible d'ouvrir le fichier: " << filename << std::endl;
+        return false;
+    }
+
+    std::vector<Entry> loaded;
+    std::string line;
+    int number = 0;
+    while (std::getline(file, line)) {
+        number++;
+        const size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        std::istringstream in(line);
+        Entry entry;
+        if (!(in >> entry.mcs)) continue; // Ligne vide
+        if (!(in >> entry.minSinr >> entry.rate) || entry.rate < 0) {
+            std::cerr << "Table de debits " << filename << " : ligne " << number << " invalide" << std::endl;
+            return false;
+        }
+        loaded.push_back(entry);
+    }
+    if (loaded.empty()) {
+        std::cerr << "Table de debits vide: " << filename << std::endl;
+        return false;
+    }
+    setEntries(loaded);
+    return true;
+}
+
+void ThroughputTable::setEntries(std::vector<Entry> sorted) {
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Entry& a, const Entry& b) { return a.minSinr < b.minSinr; });
+    entries = sorted;
+    thresholds.clear();
+    mcsByLevel.assign(1, -1);
+    rateByLevel.assign(1, 0.0);
+    for (const Entry& entry : entries) {
+        thresholds.push_back(entry.minSinr);
+        mcsByLevel.push_back(entry.mcs);
+        rateByLevel.push_back(entry.rate);
+    }
+}
+
+void ThroughputTable::lookup(const double* sinr, int count, int* mcs, double* rate) const {
+    // Niveau de chaque point (nombre de seuils atteints), compté dans mcs
+    std::fill(mcs, mcs + count, 0);
+    for (double threshold : thresholds) {
+        for (int i = 0; i < count; i++) mcs[i] += sinr[i] >= threshold;
+    }
+    for (int i = 0; i < count; i++) {
+        rate[i] = rateByLevel[mcs[i]];
+        mcs[i] = mcsByLevel[mcs[i]];
+    }
+}
+
+double ThroughputTable::maxRate() const {
+    return *std::max_element(rateByLevel.begin(), rateByLevel.end());
+}
@@ -0,0 +1,281 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+#include "../headers/tiled_map.hpp"
+#include "../headers/parallel.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const char TILED_MAGIC[4] = {'P', 'T', 'I', 'L'};
+    const uint32_t TILED_VERSION = 1;
+
+    // En-tête au début du fichier
+    struct TiledHeader {
+        char magic[4];
+        uint32_t version;
+        int32_t width, height, tileSize;
+        uint32_t reserved;
+        uint64_t hash;
+    };
+}
+
+Tile TiledMap::tileBounds(size_t index) const {
+    const int x0 = static_cast<int>(index % tilesX) * Room::TILE_SIZE;
+    const int y0 = static_cast<int>(index / tilesX) * Room::TILE_SIZE;
+    return {x0, y0, std::min(x0 + Room::TILE_SIZE, room.width), std::min(y0 + Room::TILE_SIZE, room.height)};
+}
+
+void TiledMap::computeTile(size_t index, double* data, int threads, bool accumulate) const {
+    const Tile tile = tileBounds(index);
+    const std::vector<const Obstacle*> nearby = room.obstaclesTouching(tile);
+    // Groupe suivant : calculé à part, puis maximum avec la tuile
+    std::vector<double> scratch(accumulate ? static_cast<size_t>(Room::TILE_SIZE) * Room::TILE_SIZE : 0);
+    double* target = accumulate ? scratch.data() : data;
+    // Bandes de lignes en parallèle, chacune classant ses obstacles une fois
+    const int rows = tile.y1 - tile.y0;
+    const int bands = std::max(1, std::min(threads > 0 ? threads : hardwareThreads(), rows));
+    const int bandHeight = (rows + bands - 1) / bands;
+    parallelFor(bands, threads, [&](int band) {
+        const Tile part = {tile.x0, tile.y0 + band * bandHeight, tile.x1, std::min(tile.y1, tile.y0 + (band + 1) * bandHeight)};
+        if (part.y0 >= part.y1) return;
+        const size_t offset = static_cast<size_t>(part.y0 - tile.y0) * Room::TILE_SIZE;
+        room.computeTilePower(part, occlusion.get(), bounded, target + offset, Room::TILE_SIZE);
+        for (int y = part.y0; y < part.y1; y++) {
+            for (int x = part.x0; x < part.x1; x++) {
+                const size_t i = offset + static_cast<size_t>(y - part.y0) * Room::TILE_SIZE + (x - part.x0);
+                if (room.isMarkedAsObstacle(x, y, nearby)) data[i] = -555;
+                else if (accumulate) data[i] = std::max(data[i], target[i]);
+            }
+        }
+    });
+}
+
+void TiledMap::prepareOcclusion() {
+    if (enginePrepared) return;
+    occlusion = room.prepareEngineGroup(0);
+    enginePrepared = true;
+}
+
+bool TiledMap::grouped() const {
+    return occlusion && occlusion->endEmitter < room.emitters.size();
+}
+
+double TiledMap::at(int x, int y) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const size_t index = static_cast<size_t>(y / Room::TILE_SIZE) * tilesX + x / Room::TILE_SIZE;
+    const double* data = acquireTile(index);
+    if (!data) return std::numeric_limits<double>::quiet_NaN();
+    return data[static_cast<size_t>(y % Room::TILE_SIZE) * Room::TILE_SIZE + x % Room::TILE_SIZE];
+}
+
+void TiledMap::readRow(int y, int x0, int x1, double* out) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const size_t row = static_cast<size_t>(y / Room::TILE_SIZE) * tilesX;
+    const size_t offset = static_cast<size_t>(y % Room::TILE_SIZE) * Room::TILE_SIZE;
+    for (int x = x0; x < x1;) {
+        const int tx = x / Room::TILE_SIZE;
+        const int end = std::min(x1, (tx + 1) * Room::TILE_SIZE);
+        const double* tile = acquireTile(row + tx);
+        if (!tile) {
+            std::fill(out + (x - x0), out + (x1 - x0), std::numeric_limits<double>::quiet_NaN());
+            return;
+        }
+        const double* data = tile + offset;
+        std::copy(data + (x - tx * Room::TILE_SIZE), data + (end - tx * Room::TILE_SIZE), out + (x - x0));
+        x = end;
+    }
+}
+
+size_t TiledMap::computedTiles() const {
+    if (!states) return 0;
+    return static_cast<size_t>(std::count(states, states + tileCount(), 1));
+}
+
+#ifdef _WIN32
+
+TiledMap::TiledMap(const Room& room, const std::string& filename, size_t maxResidentTiles)
+: room(room), maxResident(maxResidentTiles) {
+    std::cerr << "La carte par tuiles utilise mmap et n'est pas disponible sous Windows: " << filename << std::endl;
+}
+
+TiledMap::~TiledMap() {}
+double* TiledMap::mapTile(size_t) { return nullptr; }
+double* TiledMap::acquireTile(size_t) { return nullptr; }
+void TiledMap::unmapTile(size_t) {}
+bool TiledMap::computeAll() { return false; }
+bool TiledMap::computeMissing() { return false; }
+void TiledMap::flush() {}
+
+#else
+
+TiledMap::TiledMap(const Room& room, const std::string& filename, size_t maxResidentTiles)
+: room(room),
+  tilesX((room.width + Room::TILE_SIZE - 1) / Room::TILE_SIZE),
+  tilesY((room.height + Room::TILE_SIZE - 1) / Room::TILE_SIZE),
+  maxResident(std::max(maxResidentTiles, static_cast<size_t>(tilesX))) { // Une ligne de tuiles pour readRow
+
+    // Projections d'une tuile à des positions multiples de la page : TILE_BYTES (32 Kio) n'en est pas
+    // un multiple avec des pages de 64 Kio, où mmap refuserait les tuiles impaires
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    headerBytes = (sizeof(TiledHeader) + tileCount() + page - 1) / page * page;
+    tileStride = (TILE_BYTES + page - 1) / page * page;
+    const off_t fileBytes = static_cast<off_t>(headerBytes + tileCount() * tileStride);
+
+    fd = ::open(filename.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        std::cerr << "Impossible d'ouvrir la carte par tuiles: " << filename << std::endl;
+        return;
+    }
+
+    TiledHeader expected;
+    std::memcpy(expected.magic, TILED_MAGIC, sizeof(TILED_MAGIC));
+    expected.version = TILED_VERSION;
+    expected.width = room.width;
+    expected.height = room.height;
+    expected.tileSize = Room::TILE_SIZE;
+    expected.reserved = 0;
+    expected.hash = room.sceneHash();
+
+    // Fichier d'une autre scène (ou nouveau) : repart d'un fichier vide, creux sur disque
+    TiledHeader existing;
+    struct stat info;
+    const bool reusable = ::fstat(fd, &info) == 0 && info.st_size == fileBytes &&
+                          ::pread(fd, &existing, sizeof(existing), 0) == static_cast<ssize_t>(sizeof(existing)) &&
+                          std::memcmp(&existing, &expected, sizeof(expected)) == 0;
+    if (!reusable && (::ftruncate(fd, 0) != 0 || ::ftruncate(fd, fileBytes) != 0)) {
+        std::cerr << "Impossible de dimensionner la carte par tuiles: " << filename << std::endl;
+        ::close(fd);
+        fd = -1;
+        return;
+    }
+
+    void* mapped = ::mmap(nullptr, headerBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) {
+        std::cerr << "Impossible de projeter la carte par tuiles: " << filename << std::endl;
+        ::close(fd);
+        fd = -1;
+        return;
+    }
+    header = static_cast<uint8_t*>(mapped);
+    states = header + sizeof(TiledHeader);
+    if (!reusable) std::memcpy(header, &expected, sizeof(expected));
+    bounded = room.obstaclesOnlyAttenuate();
+}
+
+TiledMap::~TiledMap() {
+    if (fd < 0) return;
+    flush();
+    while (!lru.empty()) unmapTile(lru.back());
+    ::munmap(header, headerBytes);
+    ::close(fd);
+}
+
+double* TiledMap::mapTile(size_t index) {
+    auto it = resident.find(index);
+    if (it != resident.end()) {
+        lru.splice(lru.begin(), lru, it->second.position); // Devient la plus récente
+        return it->second.data;
+    }
+
+    while (resident.size() >= maxResident) unmapTile(lru.back());
+
+    const off_t offset = static_cast<off_t>(headerBytes + index * tileStride);
+    void* mapped = ::mmap(nullptr, TILE_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, fd, offset);
+    if (mapped == MAP_FAILED) {
+        std::cerr << "Impossible de projeter la tuile " << index << std::endl;
+        failed = true;
+        return nullptr;
+    }
+    lru.push_front(index);
+    resident[index] = {static_cast<double*>(mapped), lru.begin()};
+    return static_cast<double*>(mapped);
+}
+
+double* TiledMap::acquireTile(size_t index) {
+    if (fd < 0) return nullptr;
+    double* data = mapTile(index);
+    if (!data) return nullptr;
+    if (states[index] != 1) {
+        prepareOcclusion();
+        if (grouped()) {
+            // Préparer tous les groupes pour chaque tuile reconstruirait toutes les grilles à chaque fois
+            return computeMissing() ? mapTile(index) : nullptr;
+        }
+        computeTile(index, data, room.threads); // Lignes de la tuile en parallèle
+        states[index] = 1;
+    }
+    return data;
+}
+
+void TiledMap::unmapTile(size_t index) {
+    auto it = resident.find(index);
+    if (it == resident.end()) return;
+    ::munmap(it->second.data, TILE_BYTES); // Les pages modifiées restent à écrire par le système
+    lru.erase(it->second.position);
+    resident.erase(it);
+}
+
+bool TiledMap::computeAll() {
+    if (fd < 0) return false;
+    std::lock_guard<std::mutex> lock(mutex);
+    return computeMissing();
+}
+
+bool TiledMap::computeMissing() {
+    std::vector<size_t> missing;
+    for (size_t i = 0; i < tileCount(); i++) {
+        if (states[i] != 1) missing.push_back(i);
+    }
+    if (missing.empty()) return true;
+
+    prepareOcclusion();
+    const bool groups = grouped();
+    for (;;) {
+        // Par lots qui tiennent dans les tuiles projetées, une tuile par thread ; les groupes
+        // d'émetteurs suivants gardent le maximum avec les tuiles écrites
+        const bool accumulate = occlusion && occlusion->firstEmitter > 0;
+        for (size_t start = 0; start < missing.size(); start += maxResident) {
+            const size_t count = std::min(maxResident, missing.size() - start);
+            std::vector<double*> data(count);
+            for (size_t k = 0; k < count; k++) {
+                data[k] = mapTile(missing[start + k]);
+                if (!data[k]) return false; // Tuiles du lot et des suivants restent à calculer
+            }
+
+            parallelFor(static_cast<int>(count), room.threads, [&](int k) {
+                computeTile(missing[start + k], data[k], 1, accumulate);
+            });
+            if (!grouped()) { // Dernier groupe
+                for (size_t k = 0; k < count; k++) states[missing[start + k]] = 1;
+            }
+        }
+        if (!grouped()) break;
+        const size_t next = occlusion->endEmitter;
+        occlusion.reset(); // Grilles du groupe précédent libérées avant de préparer le suivant
+        occlusion = room.prepareEngineGroup(next);
+    }
+
+    // Plus aucune tuile à calculer : grilles du dernier groupe libérées
+    if (groups) {
+        occlusion.reset();
+        enginePrepared = false;
+    }
+    return true;
+}
+
+void TiledMap::flush() {
+    if (fd < 0) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& entry : resident) ::msync(entry.second.data, TILE_BYTES, MS_SYNC);
+    ::msync(header, headerBytes, MS_SYNC);
+}
+
+#endif